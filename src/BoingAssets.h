@@ -0,0 +1,285 @@
+// BoingAssets.h — shared CPU assets (checker mip chain, sphere meshes, sound images) and the asset pack
+// Portable (no Windows headers): the saver maps the pack or generates the assets itself, and
+// tools/BoingPackBuilder.cpp builds the pack with the very same generators.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "BoingMips.h"
+
+const int   CHECKER_TEX_SIZE = 128;
+const float ASSET_BALL_RADIUS = 0.25f;   // Sphere meshes are stored at the ball radius
+
+// Geometry modes map to sphere LODs: 0 = smooth, 1 = classic
+const int SPHERE_SMOOTH_SLICES = 64, SPHERE_SMOOTH_STACKS = 32;
+const int SPHERE_CLASSIC_SLICES = 16, SPHERE_CLASSIC_STACKS = 8;
+
+// Generated sphere (owning storage)
+struct SphereMesh {
+    int slices = 0, stacks = 0;
+    std::vector<float> positions;   // xyz at the ball radius
+    std::vector<float> normals;     // xyz, unit length
+    std::vector<float> texcoords;   // st
+    std::vector<uint16_t> indices;  // GL_TRIANGLES
+};
+
+// Read-only views used for upload; they point either into generated storage or into the mapped pack
+struct SphereMeshView {
+    int             slices = 0, stacks = 0;
+    uint32_t        vertexCount = 0, indexCount = 0;
+    const float*    positions = nullptr;
+    const float*    normals = nullptr;
+    const float*    texcoords = nullptr;
+    const uint16_t* indices = nullptr;
+};
+
+struct SoundView {
+    const unsigned char* data = nullptr;   // Complete RIFF/WAVE image (PCM), playable from memory
+    uint32_t             size = 0;
+};
+
+enum SoundId { SOUND_FLOOR = 0, SOUND_WALL = 1, SOUND_COUNT };
+
+struct SharedAssets {
+    bool ready = false;
+    bool fromPack = false;                      // Views point into the mapped asset pack
+
+    const unsigned char* checkerTexels = nullptr;   // RGB, every mip level back to back
+    TextureMip     checkerMips[MIP_MAX_LEVELS];
+    int            checkerLevels = 0;
+    SphereMeshView sphere[2];                   // Indexed by geometry mode: 0 = smooth, 1 = classic
+    SoundView      sound[SOUND_COUNT];          // Empty until packed or decoded (the saver then plays resources)
+
+    // Storage for assets generated or decoded at runtime
+    std::vector<unsigned char> ownedTexels;
+    SphereMesh                 ownedSphere[2];
+    std::vector<unsigned char> ownedSound[SOUND_COUNT];
+};
+
+// Red/white checker (16 x 8 squares) plus its mip chain down to 1x1
+inline void BuildCheckerMips(std::vector<unsigned char>& texels, TextureMip* mips, int& levels) {
+    const int TEX_SIZE = CHECKER_TEX_SIZE;
+    texels.assign(MipChainLayout(TEX_SIZE, TEX_SIZE, 3, mips, levels), 0);
+
+    unsigned char* data = &texels[0];
+    for (int y = 0; y < TEX_SIZE; ++y) {
+        for (int x = 0; x < TEX_SIZE; ++x) {
+            int cx = x / (TEX_SIZE / 16), cy = y / (TEX_SIZE / 8);
+            bool red = ((cx + cy) % 2) == 0;
+            unsigned char r = red ? 220 : 240;
+            unsigned char g = red ? 30 : 240;
+            unsigned char b = red ? 30 : 240;
+            int i = (y * TEX_SIZE + x) * 3;
+            data[i] = r; data[i + 1] = g; data[i + 2] = b;
+        }
+    }
+
+    BuildMipChain(data, mips, levels, 3);
+}
+
+// Textured, smooth-normal sphere laid out exactly like gluSphere (pole on +z, s = 0 on +y)
+inline void BuildSphereMesh(SphereMesh& mesh, int slices, int stacks, float radius) {
+    const float PI = 3.14159265f;
+    mesh.slices = slices;
+    mesh.stacks = stacks;
+    mesh.positions.clear();
+    mesh.normals.clear();
+    mesh.texcoords.clear();
+    mesh.indices.clear();
+
+    for (int i = 0; i <= stacks; ++i) {
+        float rho = PI * (float)i / (float)stacks;
+        for (int j = 0; j <= slices; ++j) {
+            float theta = (j == slices) ? 0.0f : 2.0f * PI * (float)j / (float)slices;
+            float nx = -sinf(theta) * sinf(rho);
+            float ny = cosf(theta) * sinf(rho);
+            float nz = cosf(rho);
+            mesh.normals.push_back(nx);
+            mesh.normals.push_back(ny);
+            mesh.normals.push_back(nz);
+            mesh.positions.push_back(nx * radius);
+            mesh.positions.push_back(ny * radius);
+            mesh.positions.push_back(nz * radius);
+            mesh.texcoords.push_back((float)j / (float)slices);
+            mesh.texcoords.push_back(1.0f - (float)i / (float)stacks);
+        }
+    }
+
+    const int row = slices + 1;
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            uint16_t a = (uint16_t)(i * row + j);
+            uint16_t b = (uint16_t)((i + 1) * row + j);
+            uint16_t c = (uint16_t)(i * row + j + 1);
+            uint16_t d = (uint16_t)((i + 1) * row + j + 1);
+            mesh.indices.push_back(a); mesh.indices.push_back(b); mesh.indices.push_back(c);
+            mesh.indices.push_back(c); mesh.indices.push_back(b); mesh.indices.push_back(d);
+        }
+    }
+}
+
+inline SphereMeshView ViewOf(const SphereMesh& mesh) {
+    SphereMeshView v;
+    v.slices = mesh.slices;
+    v.stacks = mesh.stacks;
+    v.vertexCount = (uint32_t)(mesh.positions.size() / 3);
+    v.indexCount = (uint32_t)mesh.indices.size();
+    v.positions = mesh.positions.data();
+    v.normals = mesh.normals.data();
+    v.texcoords = mesh.texcoords.data();
+    v.indices = mesh.indices.data();
+    return v;
+}
+
+// Bytes a context holds once it has uploaded an asset (driver padding aside): every checker level
+// as RGB, and a sphere's positions, normals, texcoords and 16-bit indices
+inline size_t CheckerUploadBytes(const SharedAssets& assets) {
+    size_t bytes = 0;
+    for (int i = 0; i < assets.checkerLevels; ++i)
+        bytes += (size_t)assets.checkerMips[i].width * (size_t)assets.checkerMips[i].height * 3;
+    return bytes;
+}
+
+inline size_t SphereUploadBytes(const SphereMeshView& mesh) {
+    return (size_t)mesh.vertexCount * 8 * sizeof(float) + (size_t)mesh.indexCount * sizeof(uint16_t);
+}
+
+// Generators for the assets the pack would otherwise provide (sounds excepted). Each one writes
+// only its own members, so they can run on different threads at once.
+inline void GenerateCheckerAsset(SharedAssets& assets) {
+    BuildCheckerMips(assets.ownedTexels, assets.checkerMips, assets.checkerLevels);
+    assets.checkerTexels = assets.ownedTexels.data();
+}
+
+inline void GenerateSphereAsset(SharedAssets& assets, int lod) {
+    if (lod == 0) BuildSphereMesh(assets.ownedSphere[0], SPHERE_SMOOTH_SLICES, SPHERE_SMOOTH_STACKS, ASSET_BALL_RADIUS);
+    else          BuildSphereMesh(assets.ownedSphere[1], SPHERE_CLASSIC_SLICES, SPHERE_CLASSIC_STACKS, ASSET_BALL_RADIUS);
+    assets.sphere[lod] = ViewOf(assets.ownedSphere[lod]);
+}
+
+inline void GenerateSharedAssets(SharedAssets& assets) {
+    GenerateCheckerAsset(assets);
+    GenerateSphereAsset(assets, 0);
+    GenerateSphereAsset(assets, 1);
+    assets.fromPack = false;
+}
+
+// Asset pack
+// Little-endian file: header, entry table, then payloads each starting on a 16-byte boundary so
+// they can be handed to GL and PlaySound straight out of the mapped view.
+//   Checker: a = base size, b = levels; RGB levels back to back (same layout as MipChainLayout)
+//   Sphere:  a = slices, b = stacks, c = radius bits; positions, normals, texcoords, indices (each aligned)
+//   Sound:   a complete 16-bit PCM RIFF/WAVE image (already decoded)
+const uint32_t ASSET_PACK_MAGIC = 0x4B504242;   // "BBPK"
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint32_t ASSET_PACK_ALIGN = 16;
+const char     ASSET_PACK_FILE[] = "BoingBallSaver.pak";
+
+enum AssetId : uint32_t {
+    ASSET_CHECKER_MIPS = 1,
+    ASSET_SPHERE_SMOOTH = 2,
+    ASSET_SPHERE_CLASSIC = 3,
+    ASSET_SOUND_FLOOR = 4,
+    ASSET_SOUND_WALL = 5
+};
+
+struct AssetPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t totalSize;     // Whole file, used to reject truncated packs
+};
+
+struct AssetPackEntry {
+    uint32_t id;
+    uint32_t offset;        // From the start of the file
+    uint32_t size;
+    uint32_t a, b, c;       // Per-type parameters (see above)
+};
+
+inline uint32_t AssetAlignUp(uint32_t v) {
+    return (v + ASSET_PACK_ALIGN - 1) & ~(ASSET_PACK_ALIGN - 1);
+}
+
+// Section offsets of a packed sphere relative to its payload; returns the payload size
+inline uint32_t SphereSectionLayout(int slices, int stacks, uint32_t offsets[4]) {
+    uint32_t vertices = (uint32_t)((slices + 1) * (stacks + 1));
+    uint32_t indices = (uint32_t)(6 * slices * stacks);
+    offsets[0] = 0;
+    offsets[1] = AssetAlignUp(offsets[0] + vertices * 3u * 4u);
+    offsets[2] = AssetAlignUp(offsets[1] + vertices * 3u * 4u);
+    offsets[3] = AssetAlignUp(offsets[2] + vertices * 2u * 4u);
+    return offsets[3] + indices * 2u;
+}
+
+// Point the asset views into a mapped pack. Only the header and entry table are read: payloads are
+// used in place. Returns false (leaving assets untouched) if anything does not match this build.
+inline bool AttachAssetPack(SharedAssets& assets, const unsigned char* base, size_t size) {
+    if (!base || size < sizeof(AssetPackHeader)) return false;
+    AssetPackHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION) return false;
+    if (header.totalSize != size) return false;
+    if (header.entryCount > 64 || sizeof(AssetPackHeader) + header.entryCount * sizeof(AssetPackEntry) > size) return false;
+
+    const AssetPackEntry* entries = (const AssetPackEntry*)(base + sizeof(AssetPackHeader));
+    const AssetPackEntry* found[6] = {};
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const AssetPackEntry& e = entries[i];
+        if (e.id < ASSET_CHECKER_MIPS || e.id > ASSET_SOUND_WALL) continue;
+        if ((e.offset % ASSET_PACK_ALIGN) != 0 || e.offset > size || e.size > size - e.offset) return false;
+        found[e.id] = &e;
+    }
+
+    // Texture: must be the chain this build would generate
+    const AssetPackEntry* tex = found[ASSET_CHECKER_MIPS];
+    if (!tex || tex->a != (uint32_t)CHECKER_TEX_SIZE) return false;
+    TextureMip mips[MIP_MAX_LEVELS];
+    int levels = 0;
+    if (MipChainLayout(CHECKER_TEX_SIZE, CHECKER_TEX_SIZE, 3, mips, levels) != tex->size || tex->b != (uint32_t)levels) return false;
+
+    // Meshes: matching LOD and radius
+    SphereMeshView spheres[2];
+    const uint32_t ids[2] = { ASSET_SPHERE_SMOOTH, ASSET_SPHERE_CLASSIC };
+    const int slices[2] = { SPHERE_SMOOTH_SLICES, SPHERE_CLASSIC_SLICES };
+    const int stacks[2] = { SPHERE_SMOOTH_STACKS, SPHERE_CLASSIC_STACKS };
+    for (int m = 0; m < 2; ++m) {
+        const AssetPackEntry* e = found[ids[m]];
+        float radius = 0.0f;
+        if (e) std::memcpy(&radius, &e->c, sizeof(radius));
+        if (!e || e->a != (uint32_t)slices[m] || e->b != (uint32_t)stacks[m] || radius != ASSET_BALL_RADIUS) return false;
+        uint32_t off[4];
+        if (SphereSectionLayout(slices[m], stacks[m], off) != e->size) return false;
+        const unsigned char* p = base + e->offset;
+        SphereMeshView& v = spheres[m];
+        v.slices = slices[m];
+        v.stacks = stacks[m];
+        v.vertexCount = (uint32_t)((slices[m] + 1) * (stacks[m] + 1));
+        v.indexCount = (uint32_t)(6 * slices[m] * stacks[m]);
+        v.positions = (const float*)(p + off[0]);
+        v.normals = (const float*)(p + off[1]);
+        v.texcoords = (const float*)(p + off[2]);
+        v.indices = (const uint16_t*)(p + off[3]);
+    }
+
+    // Commit (sounds are optional; a pack without them keeps the embedded resources)
+    assets.checkerTexels = base + tex->offset;
+    for (int i = 0; i < levels; ++i) assets.checkerMips[i] = mips[i];
+    assets.checkerLevels = levels;
+    assets.sphere[0] = spheres[0];
+    assets.sphere[1] = spheres[1];
+    for (int s = 0; s < SOUND_COUNT; ++s) {
+        const AssetPackEntry* e = found[(s == SOUND_FLOOR) ? ASSET_SOUND_FLOOR : ASSET_SOUND_WALL];
+        if (e && e->size >= 12 && std::memcmp(base + e->offset, "RIFF", 4) == 0 && std::memcmp(base + e->offset + 8, "WAVE", 4) == 0) {
+            assets.sound[s].data = base + e->offset;
+            assets.sound[s].size = e->size;
+        }
+    }
+    assets.fromPack = true;
+    return true;
+}
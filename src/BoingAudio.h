@@ -0,0 +1,253 @@
+// BoingAudio.h — WAVE parsing and IMA ADPCM (WAVE_FORMAT_IMA_ADPCM) encode/decode for the bounce sounds
+// Portable (no Windows headers): the saver decodes its compressed resources once at startup, and the
+// tools use the same code to encode them and to benchmark the decoder.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+const uint16_t WAVE_TAG_PCM = 0x0001;
+const uint16_t WAVE_TAG_IMA_ADPCM = 0x0011;
+const uint16_t IMA_BLOCK_ALIGN_PER_CHANNEL = 1024;   // 2041 frames per block for 48 kHz stereo
+
+// What ParseWave found in a RIFF/WAVE image (data points into the image)
+struct WaveInfo {
+    uint16_t formatTag = 0;
+    uint16_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint16_t bitsPerSample = 0;
+    uint16_t blockAlign = 0;
+    uint16_t samplesPerBlock = 0;   // IMA ADPCM only
+    uint32_t frames = 0;            // Sample frames (from "fact" for ADPCM, from the data size for PCM)
+    const unsigned char* data = nullptr;
+    uint32_t dataSize = 0;
+};
+
+inline uint16_t WaveU16(const unsigned char* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t WaveU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+inline void WavePut16(std::vector<unsigned char>& out, uint16_t v) {
+    out.push_back((unsigned char)(v & 0xFF)); out.push_back((unsigned char)(v >> 8));
+}
+inline void WavePut32(std::vector<unsigned char>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back((unsigned char)((v >> (8 * i)) & 0xFF));
+}
+inline void WavePutTag(std::vector<unsigned char>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+// Parse the fmt/fact/data chunks; only 16-bit PCM and 4-bit IMA ADPCM are accepted
+inline bool ParseWave(const unsigned char* image, size_t size, WaveInfo& info) {
+    info = WaveInfo();
+    if (!image || size < 12 || std::memcmp(image, "RIFF", 4) != 0 || std::memcmp(image + 8, "WAVE", 4) != 0) return false;
+
+    bool haveFmt = false;
+    uint32_t factFrames = 0;
+    for (size_t pos = 12; pos + 8 <= size;) {
+        const unsigned char* chunk = image + pos;
+        uint32_t chunkSize = WaveU32(chunk + 4);
+        if (chunkSize > size - pos - 8) chunkSize = (uint32_t)(size - pos - 8);   // Tolerate a short last chunk
+        const unsigned char* body = chunk + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16) {
+            info.formatTag = WaveU16(body);
+            info.channels = WaveU16(body + 2);
+            info.sampleRate = WaveU32(body + 4);
+            info.blockAlign = WaveU16(body + 12);
+            info.bitsPerSample = WaveU16(body + 14);
+            if (info.formatTag == WAVE_TAG_IMA_ADPCM && chunkSize >= 20) info.samplesPerBlock = WaveU16(body + 18);
+            haveFmt = true;
+        }
+        else if (std::memcmp(chunk, "fact", 4) == 0 && chunkSize >= 4) {
+            factFrames = WaveU32(body);
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            info.data = body;
+            info.dataSize = chunkSize;
+        }
+        pos += 8 + (size_t)chunkSize + (chunkSize & 1);
+    }
+    if (!haveFmt || !info.data || info.channels == 0 || info.channels > 2 || info.blockAlign == 0) return false;
+
+    if (info.formatTag == WAVE_TAG_PCM) {
+        if (info.bitsPerSample != 16) return false;
+        info.frames = info.dataSize / info.blockAlign;
+        return true;
+    }
+    if (info.formatTag == WAVE_TAG_IMA_ADPCM) {
+        uint32_t header = 4u * info.channels;
+        if (info.bitsPerSample != 4 || info.blockAlign <= header) return false;
+        uint16_t expected = (uint16_t)((info.blockAlign - header) * 8u / (4u * info.channels) + 1u);
+        if (info.samplesPerBlock != expected) return false;
+        uint32_t blocks = info.dataSize / info.blockAlign;
+        info.frames = factFrames ? factFrames : blocks * info.samplesPerBlock;
+        if (info.frames > blocks * (uint32_t)info.samplesPerBlock) info.frames = blocks * info.samplesPerBlock;
+        return true;
+    }
+    return false;
+}
+
+// IMA ADPCM tables
+static const int kImaIndexTable[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+static const int kImaStepTable[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+struct ImaChannelState {
+    int predictor = 0;
+    int index = 0;
+};
+
+// Apply one 4-bit code to the channel state and return the reconstructed sample
+inline int16_t ImaExpandNibble(ImaChannelState& s, unsigned nibble) {
+    int step = kImaStepTable[s.index];
+    int diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    s.predictor += (nibble & 8) ? -diff : diff;
+    if (s.predictor > 32767) s.predictor = 32767;
+    else if (s.predictor < -32768) s.predictor = -32768;
+    s.index += kImaIndexTable[nibble & 7];
+    if (s.index < 0) s.index = 0;
+    else if (s.index > 88) s.index = 88;
+    return (int16_t)s.predictor;
+}
+
+// Pick the code that best approaches the sample, updating the state exactly as the decoder will
+inline unsigned ImaCompressSample(ImaChannelState& s, int sample) {
+    int step = kImaStepTable[s.index];
+    int diff = sample - s.predictor;
+    unsigned nibble = 0;
+    if (diff < 0) { nibble = 8; diff = -diff; }
+    if (diff >= step) { nibble |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) nibble |= 1;
+    ImaExpandNibble(s, nibble);
+    return nibble;
+}
+
+// Decode IMA ADPCM blocks into interleaved 16-bit PCM (info.frames frames)
+inline bool ImaAdpcmDecode(const WaveInfo& info, std::vector<int16_t>& pcm) {
+    if (info.formatTag != WAVE_TAG_IMA_ADPCM) return false;
+    const int ch = info.channels;
+    const uint32_t spb = info.samplesPerBlock;
+    pcm.assign((size_t)info.frames * ch, 0);
+
+    uint32_t frame = 0;
+    for (const unsigned char* block = info.data;
+        frame < info.frames && block + info.blockAlign <= info.data + info.dataSize; block += info.blockAlign) {
+        ImaChannelState state[2];
+        for (int c = 0; c < ch; ++c) {
+            state[c].predictor = (int16_t)WaveU16(block + 4 * c);
+            state[c].index = block[4 * c + 2];
+            if (state[c].index > 88) return false;
+            pcm[(size_t)frame * ch + c] = (int16_t)state[c].predictor;
+        }
+        uint32_t blockFrames = (info.frames - frame < spb) ? info.frames - frame : spb;
+
+        // After the headers: per channel, 4 bytes (8 samples, low nibble first), channels interleaved
+        const unsigned char* p = block + 4 * ch;
+        for (uint32_t group = 0; 1 + group * 8 < blockFrames; ++group) {
+            for (int c = 0; c < ch; ++c) {
+                for (int b = 0; b < 4; ++b, ++p) {
+                    uint32_t f = 1 + group * 8 + (uint32_t)b * 2;
+                    int16_t lo = ImaExpandNibble(state[c], *p & 0x0F);
+                    int16_t hi = ImaExpandNibble(state[c], *p >> 4);
+                    if (f < blockFrames)     pcm[(size_t)(frame + f) * ch + c] = lo;
+                    if (f + 1 < blockFrames) pcm[(size_t)(frame + f + 1) * ch + c] = hi;
+                }
+            }
+        }
+        frame += blockFrames;
+    }
+    return frame == info.frames;
+}
+
+// Encode interleaved 16-bit PCM into IMA ADPCM blocks (the last block is padded with silence)
+inline void ImaAdpcmEncode(const int16_t* pcm, uint32_t frames, int ch, uint16_t blockAlign, std::vector<unsigned char>& out) {
+    const uint32_t spb = (uint32_t)(blockAlign - 4 * ch) * 8u / (4u * ch) + 1u;
+    out.clear();
+    ImaChannelState state[2];
+    for (uint32_t frame = 0; frame < frames; frame += spb) {
+        size_t start = out.size();
+        auto sampleAt = [&](uint32_t f, int c) -> int { return (f < frames) ? pcm[(size_t)f * ch + c] : 0; };
+
+        // Block header: exact first sample, current step index
+        for (int c = 0; c < ch; ++c) {
+            state[c].predictor = sampleAt(frame, c);
+            WavePut16(out, (uint16_t)(int16_t)state[c].predictor);
+            out.push_back((unsigned char)state[c].index);
+            out.push_back(0);
+        }
+        for (uint32_t group = 0; 1 + group * 8 < spb; ++group) {
+            for (int c = 0; c < ch; ++c) {
+                for (int b = 0; b < 4; ++b) {
+                    uint32_t f = frame + 1 + group * 8 + (uint32_t)b * 2;
+                    unsigned lo = ImaCompressSample(state[c], sampleAt(f, c));
+                    unsigned hi = ImaCompressSample(state[c], sampleAt(f + 1, c));
+                    out.push_back((unsigned char)(lo | (hi << 4)));
+                }
+            }
+        }
+        out.resize(start + blockAlign, 0);
+    }
+}
+
+// Complete 16-bit PCM RIFF/WAVE image (what PlaySound(SND_MEMORY) plays)
+inline void BuildPcmWave(const int16_t* pcm, uint32_t frames, int ch, uint32_t rate, std::vector<unsigned char>& out) {
+    uint32_t dataSize = frames * (uint32_t)ch * 2u;
+    out.clear();
+    out.reserve(44 + dataSize);
+    WavePutTag(out, "RIFF"); WavePut32(out, 36 + dataSize); WavePutTag(out, "WAVE");
+    WavePutTag(out, "fmt "); WavePut32(out, 16);
+    WavePut16(out, WAVE_TAG_PCM); WavePut16(out, (uint16_t)ch);
+    WavePut32(out, rate); WavePut32(out, rate * (uint32_t)ch * 2u);
+    WavePut16(out, (uint16_t)(ch * 2)); WavePut16(out, 16);
+    WavePutTag(out, "data"); WavePut32(out, dataSize);
+    const unsigned char* bytes = (const unsigned char*)pcm;
+    out.insert(out.end(), bytes, bytes + dataSize);   // Little-endian hosts only (Windows, x86/ARM Linux)
+}
+
+// Complete IMA ADPCM RIFF/WAVE image with fmt (cbSize = 2) and fact chunks
+inline void BuildImaWave(const int16_t* pcm, uint32_t frames, int ch, uint32_t rate, std::vector<unsigned char>& out) {
+    const uint16_t blockAlign = (uint16_t)(IMA_BLOCK_ALIGN_PER_CHANNEL * ch);
+    const uint16_t spb = (uint16_t)((blockAlign - 4 * ch) * 8 / (4 * ch) + 1);
+    std::vector<unsigned char> blocks;
+    ImaAdpcmEncode(pcm, frames, ch, blockAlign, blocks);
+
+    out.clear();
+    WavePutTag(out, "RIFF"); WavePut32(out, 4 + 28 + 12 + 8 + (uint32_t)blocks.size()); WavePutTag(out, "WAVE");
+    WavePutTag(out, "fmt "); WavePut32(out, 20);
+    WavePut16(out, WAVE_TAG_IMA_ADPCM); WavePut16(out, (uint16_t)ch);
+    WavePut32(out, rate); WavePut32(out, (uint32_t)((uint64_t)rate * blockAlign / spb));
+    WavePut16(out, blockAlign); WavePut16(out, 4);
+    WavePut16(out, 2); WavePut16(out, spb);
+    WavePutTag(out, "fact"); WavePut32(out, 4); WavePut32(out, frames);
+    WavePutTag(out, "data"); WavePut32(out, (uint32_t)blocks.size());
+    out.insert(out.end(), blocks.begin(), blocks.end());
+}
+
+// Turn any supported WAVE image into a 16-bit PCM image (ADPCM is decoded, PCM is copied)
+inline bool DecodeToPcmWave(const unsigned char* image, size_t size, std::vector<unsigned char>& out) {
+    WaveInfo info;
+    if (!ParseWave(image, size, info)) return false;
+    if (info.formatTag == WAVE_TAG_PCM) {
+        out.assign(image, image + size);
+        return true;
+    }
+    std::vector<int16_t> pcm;
+    if (!ImaAdpcmDecode(info, pcm)) return false;
+    BuildPcmWave(pcm.data(), info.frames, info.channels, info.sampleRate, out);
+    return true;
+}
@@ -13,10 +13,17 @@
 #include <commdlg.h>
 #include <cstdint>
 #include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+#include <new>
 
 #ifndef GL_CLAMP_TO_EDGE
 #define GL_CLAMP_TO_EDGE 0x812F
 #endif
+#ifndef GL_BGRA_EXT
+#define GL_BGRA_EXT 0x80E1
+#endif
 
 #pragma comment(lib, "winmm.lib")
 #pragma comment(lib, "opengl32.lib")
@@ -26,6 +33,18 @@
 #pragma comment(lib, "Advapi32.lib")
 
 #include "resource.h"
+#include "BoingSettings.h"
+#include "BoingAssets.h"
+#include "BoingAudio.h"
+#include "BoingCoreGL.h"
+#include "BoingExport.h"
+#include "BoingJobs.h"
+#include "BoingMemory.h"
+#include "BoingPacing.h"
+#include "BoingParticles.h"
+#include "BoingReplay.h"
+#include "BoingScene.h"
+#include "BoingSim.h"
 
 // Class name (versioned and constant for this build)
 static const wchar_t* kSaverClassName = L"BoingBallSaver_v3";
@@ -39,195 +58,119 @@ bool      g_preview = false;
 bool      g_soundPlayedThisFrame = false;
 bool      g_cursorHidden = false;
 
+// Display topology changed (monitor added/removed/re-arranged); outputs are rebuilt by the main loop
+static bool g_displayChanged = false;
+
+// Set while a single output is torn down so its WM_DESTROY does not end the saver
+static bool g_retiringOutput = false;
+
+// Heap accounting
+// Every C++ heap allocation in the process goes through these, so telemetry can report allocations
+// per frame and debug builds can assert that the steady-state render loop allocates nothing.
+std::atomic<uint64_t> g_heapAllocs(0);
+
+void* operator new(size_t size) {
+    g_heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Job system shared by asset preparation, output setup and the particle update; started once the
+// settings are known (WorkerThreads caps it on shared hosts)
+JobSystem g_jobs;
+
 // Physics constants
 float g_timeScale = 0.5f;
-float BALL_RADIUS = 0.25f;
+float BALL_RADIUS = ASSET_BALL_RADIUS;   // Sphere meshes are generated (or packed) at this radius
 float GRAVITY = -9.8f;
 
-// Global ball state (used in Single and Replicated modes)
-float g_ballX = 0.0f, g_ballY = 0.0f, g_ballZ = 0.0f;
-float g_vx = 0.8f, g_vy = 4.5f, g_vz = 0.0f;
-float g_spinAngle = 0.0f, g_spinSpeed = 120.0f;
-int   g_spinDir = 1;
+// Global ball state (used in Single, Replicated and Spanned modes)
+BallState g_ball;
+float g_spinSpeed = 120.0f;
 
 // Global bounds used for global physics (replicated/single)
 float g_WALL_X = 1.0f, g_WALL_Z = 1.0f, g_FLOOR_Y = -1.0f;
 
+// Run recording: the writer, whether bounds changed since the last tick, and whether the set of
+// balls was re-seeded (run start, outputs rebuilt) rather than carried on
+ReplayWriter g_recorder;
+bool         g_recordLayoutDirty = true;
+bool         g_recordLayoutFresh = true;
+
 // Timing
 LARGE_INTEGER g_freq = {}, g_prev = {};
 
-// User settings
-bool     g_floorShadowEnabled = true;
-bool     g_wallShadowEnabled = true;
-bool     g_gridEnabled = true;
-bool     g_soundEnabled = true;
-COLORREF g_bgColor = RGB(192, 192, 192);
-int      g_geometryMode = 1;  // 1 = low, 0 = high (kept same semantics as prior)
-bool     g_ballLightingEnabled = true;
-int      g_multiMonitorMode = 0;  // 0=Single, 1=Extended, 2=Replicated, 3=Unified
-
-// Defaults
-const bool     DEFAULT_FLOOR_SHADOW = true;
-const bool     DEFAULT_WALL_SHADOW = true;
-const bool     DEFAULT_GRID = true;
-const bool     DEFAULT_SOUND = true;
-const COLORREF DEFAULT_BG_COLOR = RGB(192, 192, 192);
-const int      DEFAULT_GEOMETRY_MODE = 1;
-const bool     DEFAULT_BALL_LIGHTING = true;
-const int      DEFAULT_MULTI_MONITOR_MODE = 0;
+// Frame pacing (BoingPacing.h): the main loop sleeps on a waitable timer between frames, at a
+// cadence chosen from the display and power source state the system reports
+FramePacer    g_pacer;
+PowerState    g_power;
+PowerCounters g_powerCounters;
+HANDLE        g_frameTimer = nullptr;   // High resolution where available, for full cadence
+HANDLE        g_idleTimer = nullptr;    // Plain timer whose wakeups the OS may coalesce
+LARGE_INTEGER g_wakeAt = {};            // When the loop last came back from its wait
+float         g_frameWorkMs = 0.0f;     // Busy time of the last loop iteration (no waiting)
+
+// User settings (immutable snapshot, loaded once before any window creation)
+SaverSettings g_settings;
 
 // Registry path
 static const wchar_t* kRegPath = L"Software\\AirTwerx\\BoingBallSaver";
 
-static bool ReadBoolSetting(const wchar_t* name, bool defaultVal) {
-    HKEY hKey;
-    DWORD val = 0, type = 0, size = sizeof(DWORD);
-
-    // Try 64‑bit hive first
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_64KEY, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return val != 0;
-        }
-        RegCloseKey(hKey);
+// Registry backend: one key open per hive for a whole load or save
+// Reads try the 64-bit view first and fall back to the 32-bit view; writes go to both.
+class RegistrySettingsBackend : public SettingsBackend {
+public:
+    ~RegistrySettingsBackend() override { Close(); }
+
+    bool OpenForRead() override {
+        Close();
+        if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0, KEY_READ | KEY_WOW64_64KEY, &key64_) != ERROR_SUCCESS) key64_ = nullptr;
+        if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0, KEY_READ | KEY_WOW64_32KEY, &key32_) != ERROR_SUCCESS) key32_ = nullptr;
+        return key64_ || key32_;
     }
 
-    // Fall back to 32‑bit hive
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_32KEY, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return val != 0;
-        }
-        RegCloseKey(hKey);
+    bool OpenForWrite() override {
+        Close();
+        DWORD disp = 0;
+        if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
+            KEY_WRITE | KEY_WOW64_64KEY, nullptr, &key64_, &disp) != ERROR_SUCCESS) key64_ = nullptr;
+        if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
+            KEY_WRITE | KEY_WOW64_32KEY, nullptr, &key32_, &disp) != ERROR_SUCCESS) key32_ = nullptr;
+        return key64_ || key32_;
     }
 
-    return defaultVal;
-}
-
-static int ReadIntSetting(const wchar_t* name, int defaultVal) {
-    HKEY hKey;
-    DWORD val = 0, type = 0, size = sizeof(DWORD);
-
-    // Try 64‑bit hive first
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_64KEY, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return static_cast<int>(val);
-        }
-        RegCloseKey(hKey);
+    bool ReadValue(const wchar_t* name, uint32_t& out) override {
+        return ReadFrom(key64_, name, out) || ReadFrom(key32_, name, out);
     }
 
-    // Fall back to 32‑bit hive
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_32KEY, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return static_cast<int>(val);
-        }
-        RegCloseKey(hKey);
+    void WriteValue(const wchar_t* name, uint32_t value) override {
+        DWORD v = value;
+        if (key64_) RegSetValueExW(key64_, name, 0, REG_DWORD, reinterpret_cast<const BYTE*>(&v), sizeof(DWORD));
+        if (key32_) RegSetValueExW(key32_, name, 0, REG_DWORD, reinterpret_cast<const BYTE*>(&v), sizeof(DWORD));
     }
 
-    return defaultVal;
-}
-
-
-static COLORREF ReadColorSetting(const wchar_t* name, COLORREF defaultVal) {
-    HKEY hKey;
-    DWORD val = 0, type = 0, size = sizeof(DWORD);
-
-    // Try 64‑bit hive first
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_64KEY, &hKey) == ERROR_SUCCESS) {
-        if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return static_cast<COLORREF>(val);
-        }
-        RegCloseKey(hKey);
+    void Close() override {
+        if (key64_) { RegCloseKey(key64_); key64_ = nullptr; }
+        if (key32_) { RegCloseKey(key32_); key32_ = nullptr; }
     }
 
-    // Fall back to 32‑bit hive
-    if (RegOpenKeyExW(HKEY_CURRENT_USER, kRegPath, 0,
-        KEY_READ | KEY_WOW64_32KEY, &hKey) == ERROR_SUCCESS) {
+private:
+    static bool ReadFrom(HKEY hKey, const wchar_t* name, uint32_t& out) {
+        if (!hKey) return false;
+        DWORD val = 0, type = 0, size = sizeof(DWORD);
         if (RegQueryValueExW(hKey, name, nullptr, &type,
-            reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS && type == REG_DWORD) {
-            RegCloseKey(hKey);
-            return static_cast<COLORREF>(val);
+            reinterpret_cast<LPBYTE>(&val), &size) != ERROR_SUCCESS || type != REG_DWORD) {
+            return false;
         }
-        RegCloseKey(hKey);
-    }
-
-    return defaultVal;
-}
-
-static void WriteBoolSetting(const wchar_t* name, bool value) {
-    HKEY hKey; DWORD disp = 0;
-    DWORD v = value ? 1 : 0;
-
-    // Write to 64‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_64KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&v), sizeof(DWORD));
-        RegCloseKey(hKey);
+        out = static_cast<uint32_t>(val);
+        return true;
     }
 
-    // Write to 32‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_32KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&v), sizeof(DWORD));
-        RegCloseKey(hKey);
-    }
-}
-
-static void WriteIntSetting(const wchar_t* name, int value) {
-    HKEY hKey; DWORD disp = 0;
-
-    // Write to 64‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_64KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&value), sizeof(DWORD));
-        RegCloseKey(hKey);
-    }
-
-    // Write to 32‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_32KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&value), sizeof(DWORD));
-        RegCloseKey(hKey);
-    }
-}
-
-
-static void WriteColorSetting(const wchar_t* name, COLORREF value) {
-    HKEY hKey; DWORD disp = 0;
-
-    // Write to 64‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_64KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&value), sizeof(DWORD));
-        RegCloseKey(hKey);
-    }
-
-    // Write to 32‑bit hive
-    if (RegCreateKeyExW(HKEY_CURRENT_USER, kRegPath, 0, nullptr, 0,
-        KEY_WRITE | KEY_WOW64_32KEY, nullptr, &hKey, &disp) == ERROR_SUCCESS) {
-        RegSetValueExW(hKey, name, 0, REG_DWORD,
-            reinterpret_cast<const BYTE*>(&value), sizeof(DWORD));
-        RegCloseKey(hKey);
-    }
-}
+    HKEY key64_ = nullptr;
+    HKEY key32_ = nullptr;
+};
 
 // Explicitly set monitor mode radios without relying on resource grouping
 static void SetMonitorModeRadios(HWND hDlg, int mode) {
@@ -236,13 +179,15 @@ static void SetMonitorModeRadios(HWND hDlg, int mode) {
     SendDlgItemMessage(hDlg, IDC_MONITOR_EXTENDED, BM_SETCHECK, BST_UNCHECKED, 0);
     SendDlgItemMessage(hDlg, IDC_MONITOR_REPLICATED, BM_SETCHECK, BST_UNCHECKED, 0);
     SendDlgItemMessage(hDlg, IDC_MONITOR_UNIFIED, BM_SETCHECK, BST_UNCHECKED, 0);
+    SendDlgItemMessage(hDlg, IDC_MONITOR_SPANNED, BM_SETCHECK, BST_UNCHECKED, 0);
 
     // Check the selected one
     int id =
         (mode == 0) ? IDC_MONITOR_SINGLE :
         (mode == 1) ? IDC_MONITOR_EXTENDED :
         (mode == 2) ? IDC_MONITOR_REPLICATED :
-        (mode == 3) ? IDC_MONITOR_UNIFIED : IDC_MONITOR_SINGLE;
+        (mode == 3) ? IDC_MONITOR_UNIFIED :
+        (mode == 4) ? IDC_MONITOR_SPANNED : IDC_MONITOR_SINGLE;
 
     SendDlgItemMessage(hDlg, id, BM_SETCHECK, BST_CHECKED, 0);
 }
@@ -250,20 +195,14 @@ static void SetMonitorModeRadios(HWND hDlg, int mode) {
 /* Debug helper : popup the current monitor mode with a label********************************************************
 static void DebugMode(const wchar_t* label) {
     wchar_t buf[128];
-    swprintf(buf, 128, L"%s: g_multiMonitorMode=%d", label, g_multiMonitorMode);
+    swprintf(buf, 128, L"%s: multiMonitorMode=%d", label, g_settings.multiMonitorMode);
     MessageBoxW(nullptr, buf, L"BoingBallSaver Debug", MB_OK | MB_ICONINFORMATION);
 }
 */
-// Load all settings once, before any window creation
-static void LoadSettingsFromRegistry() {
-    g_floorShadowEnabled = ReadBoolSetting(L"FloorShadow", DEFAULT_FLOOR_SHADOW);
-    g_wallShadowEnabled = ReadBoolSetting(L"WallShadow", DEFAULT_WALL_SHADOW);
-    g_gridEnabled = ReadBoolSetting(L"Grid", DEFAULT_GRID);
-    g_soundEnabled = ReadBoolSetting(L"Sound", DEFAULT_SOUND);
-    g_bgColor = ReadColorSetting(L"BackgroundColor", DEFAULT_BG_COLOR);
-    g_geometryMode = ReadIntSetting(L"GeometryMode", DEFAULT_GEOMETRY_MODE);
-    g_ballLightingEnabled = ReadBoolSetting(L"BallLighting", DEFAULT_BALL_LIGHTING);
-    g_multiMonitorMode = ReadIntSetting(L"MultiMonitorMode", DEFAULT_MULTI_MONITOR_MODE);
+// Load all settings once, before any window creation (one key open per hive)
+static SaverSettings LoadSettingsFromRegistry() {
+    RegistrySettingsBackend backend;
+    return LoadSettings(backend);
 }
 
 static void QuitSaver() {
@@ -280,6 +219,7 @@ static void SetWindowPixelFormat(HDC hdc) {
     pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
     pfd.iPixelType = PFD_TYPE_RGBA;
     pfd.cColorBits = 24;
+    pfd.cAlphaBits = 8;   // Destination alpha lets the impostor atlas capture a ball cut-out
     pfd.cDepthBits = 24;
     pfd.cStencilBits = 8;
 
@@ -288,110 +228,997 @@ static void SetWindowPixelFormat(HDC hdc) {
     SetPixelFormat(hdc, pf, &pfd);
 }
 
+// Everything that determines an output's image; equal signatures mean a pixel-identical frame
+struct FrameSignature {
+    bool     ballInView = false;           // Ball, floor shadow or wall shadow reaches this output
+    float    ballX = 0.0f, ballY = 0.0f, ballZ = 0.0f, spin = 0.0f;
+    float    floorY = 0.0f, wallX = 0.0f;
+    int      width = 0, height = 0;
+    uint32_t settings = 0;                 // Packed render toggles and geometry mode
+    COLORREF bgColor = 0;
+    uint32_t particles = 0;                // Particle update count while this output's world has any
+
+    bool operator==(const FrameSignature& o) const {
+        return ballInView == o.ballInView &&
+            ballX == o.ballX && ballY == o.ballY && ballZ == o.ballZ && spin == o.spin &&
+            floorY == o.floorY && wallX == o.wallX &&
+            width == o.width && height == o.height &&
+            settings == o.settings && bgColor == o.bgColor && particles == o.particles;
+    }
+};
+
+// Per-context GL state cache
+// Each output's context remembers the render state it last set, so enables, binds, colors and
+// matrix loads that would not change anything never reach the driver. Passes state what they need
+// instead of restoring defaults afterwards. Code that changes state behind the cache's back
+// (impostor capture, preview blits, vertex-array color) forgets the affected entries.
+enum GLCapBits : uint32_t {
+    GLCAP_LIGHTING = 1u << 0,
+    GLCAP_TEXTURE_2D = 1u << 1,
+    GLCAP_BLEND = 1u << 2,
+    GLCAP_DEPTH_TEST = 1u << 3,
+    GLCAP_ALPHA_TEST = 1u << 4,
+    GLCAP_DEPTH_WRITE = 1u << 5      // glDepthMask rather than an enable
+};
+
+struct GLStateCache {
+    uint32_t caps = 0;
+    uint32_t capsKnown = 0;          // Bits of caps that match the context
+    GLuint   texture = 0;
+    bool     textureKnown = false;
+    GLfloat  color[4] = {};
+    bool     colorKnown = false;
+    GLfloat  clearColor[4] = {};
+    bool     clearColorKnown = false;
+    GLfloat  lineWidth = 0.0f, pointSize = 0.0f;   // 0 = unknown
+    GLfloat  modelview[16] = {};
+    bool     modelviewKnown = false;
+    uint64_t issued = 0;             // State calls passed to GL
+    uint64_t filtered = 0;           // State calls dropped as redundant
+};
+
+// Nothing is assumed about the context any more (new context, or state changed outside the cache)
+static void GLForgetState(GLStateCache& gs) {
+    gs.capsKnown = 0;
+    gs.textureKnown = false;
+    gs.colorKnown = false;
+    gs.clearColorKnown = false;
+    gs.lineWidth = 0.0f;
+    gs.pointSize = 0.0f;
+    gs.modelviewKnown = false;
+}
+
+// Enable exactly the GLCAP_* bits in caps (and disable the rest)
+static void GLApplyCaps(GLStateCache& gs, uint32_t caps) {
+    static const GLenum capEnums[] = { GL_LIGHTING, GL_TEXTURE_2D, GL_BLEND, GL_DEPTH_TEST, GL_ALPHA_TEST };
+    for (uint32_t i = 0; i < 6; ++i) {
+        const uint32_t bit = 1u << i;
+        const bool on = (caps & bit) != 0;
+        if ((gs.capsKnown & bit) && ((gs.caps & bit) != 0) == on) { gs.filtered++; continue; }
+        if (bit == GLCAP_DEPTH_WRITE) glDepthMask(on ? GL_TRUE : GL_FALSE);
+        else if (on)                  glEnable(capEnums[i]);
+        else                          glDisable(capEnums[i]);
+        gs.caps = on ? (gs.caps | bit) : (gs.caps & ~bit);
+        gs.capsKnown |= bit;
+        gs.issued++;
+    }
+}
+
+static void GLBindTexture2D(GLStateCache& gs, GLuint tex) {
+    if (gs.textureKnown && gs.texture == tex) { gs.filtered++; return; }
+    glBindTexture(GL_TEXTURE_2D, tex);
+    gs.texture = tex;
+    gs.textureKnown = true;
+    gs.issued++;
+}
+
+static void GLSetColor(GLStateCache& gs, GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    if (gs.colorKnown && gs.color[0] == r && gs.color[1] == g && gs.color[2] == b && gs.color[3] == a) {
+        gs.filtered++;
+        return;
+    }
+    glColor4f(r, g, b, a);
+    gs.color[0] = r; gs.color[1] = g; gs.color[2] = b; gs.color[3] = a;
+    gs.colorKnown = true;
+    gs.issued++;
+}
+
+static void GLSetClearColor(GLStateCache& gs, GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    if (gs.clearColorKnown && gs.clearColor[0] == r && gs.clearColor[1] == g && gs.clearColor[2] == b &&
+        gs.clearColor[3] == a) {
+        gs.filtered++;
+        return;
+    }
+    glClearColor(r, g, b, a);
+    gs.clearColor[0] = r; gs.clearColor[1] = g; gs.clearColor[2] = b; gs.clearColor[3] = a;
+    gs.clearColorKnown = true;
+    gs.issued++;
+}
+
+static void GLSetLineWidth(GLStateCache& gs, GLfloat width) {
+    if (gs.lineWidth == width) { gs.filtered++; return; }
+    glLineWidth(width);
+    gs.lineWidth = width;
+    gs.issued++;
+}
+
+static void GLSetPointSize(GLStateCache& gs, GLfloat size) {
+    if (gs.pointSize == size) { gs.filtered++; return; }
+    glPointSize(size);
+    gs.pointSize = size;
+    gs.issued++;
+}
+
+// Load a column-major modelview (the matrix mode is always GL_MODELVIEW between passes)
+static void GLLoadModelview(GLStateCache& gs, const GLfloat m[16]) {
+    if (gs.modelviewKnown && memcmp(gs.modelview, m, sizeof(gs.modelview)) == 0) { gs.filtered++; return; }
+    glLoadMatrixf(m);
+    memcpy(gs.modelview, m, sizeof(gs.modelview));
+    gs.modelviewKnown = true;
+    gs.issued++;
+}
+
+// The camera transform, shifted by a world offset (spanned outputs look at their own slice)
+static void GLLoadCamera(GLStateCache& gs, float worldOffsetX) {
+    GLfloat m[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  -worldOffsetX, 0, -SCENE_CAMERA_Z, 1 };
+    GLLoadModelview(gs, m);
+}
+
+// GPU copies of the shared assets held by one output's context
+// g_assets keeps the CPU data once per process; contexts are not shared (each output is set up on
+// its own job and recovers from a loss alone), so every context uploads what it draws, on first use.
+enum GpuAsset { GPU_CHECKER, GPU_SPHERE, GPU_GRID, GPU_IMPOSTOR, GPU_ASSET_COUNT };
+
+struct GpuResidency {
+    size_t   bytes[GPU_ASSET_COUNT] = {};  // Uploaded size of each fixed-function asset (0 = not resident)
+    uint64_t uploads = 0;                  // Uploads since the last telemetry report
+
+    size_t Total() const {
+        size_t total = 0;
+        for (size_t b : bytes) total += b;
+        return total;
+    }
+};
+
 // Per-monitor window structure (per-context resources)
 struct MonitorWindow {
     HWND   hWnd = nullptr;
     HDC    hDC = nullptr;
     HGLRC  hGL = nullptr;
+    GLStateCache glState;          // What this window's context is known to have set
+    ULONGLONG    contextRetryAt = 0;   // After a failed context recovery, when to try again (GetTickCount64)
 
     // Per-window GL resources
     GLuint     checkerTex = 0;
-    GLUquadric* quadric = nullptr;
+
+    // Per-window display lists (compiled once, replayed every frame)
+    GLuint sphereList = 0;         // Shared sphere mesh for sphereListGeometry (EnsureSphereList)
+    int    sphereListGeometry = -1;
+    GLuint gridList = 0;           // Floor and back-wall grid lines for gridListFloorY
+    float  gridListFloorY = 0.0f;
+
+    // Per-window impostor atlas (pre-rendered spin angles, keyed by resolution bucket)
+    GLuint impostorTex = 0;
+    int    impostorCell = 0;       // Cell size in pixels (0 = not built)
+    int    impostorGeometry = -1;  // Geometry mode the atlas was captured with
+    bool   impostorLit = false;    // Lighting mode the atlas was captured with
+
+    GpuResidency gpu;              // What the resources above hold on the GPU
+
+    // Shader renderer, when this window got a core-profile context (Renderer setting); it owns
+    // its buffers and programs and draws instead of everything above
+    CoreRenderer core;
 
     // Per-window world bounds (derived from viewport)
     float wallX = 1.0f, wallZ = 1.0f, floorY = -1.0f;
 
+    // Cached view: client size the bounds were computed for; projection reloaded only when dirty
+    int  viewW = 0, viewH = 0;
+    bool projectionDirty = true;
+
+    // Spanned world placement (monitor rectangle and this window's centre in world X)
+    RECT  monitorRect = {};         // Window rectangle in virtual-screen pixels (all modes)
+    float worldOffsetX = 0.0f;
+
+    // Startup cost of this output's context and resources
+    double setupMs = 0.0;
+
+    // Inputs of the last presented frame (skip-present when unchanged)
+    FrameSignature lastFrame;
+    bool           framePresented = false;
+
     // Per-window ball state
-    float ballX = -0.5f, ballY = 0.0f, ballZ = 0.0f;
-    float vx = 0.8f, vy = 4.5f, vz = 0.0f;
-    float spinAngle = 0.0f;
-    int   spinDir = 1;
+    BallState ball = { -0.5f, 0.0f, 0.0f, 0.8f, 4.5f, 0.0f, 0.0f, 1 };
+
+    // Shared-memory frame export (FrameExport setting): mapping, its ring writer, number in its name
+    HANDLE           exportMapping = nullptr;
+    ExportRingWriter exporter;
+    int              exportIndex = -1;
+};
+
+// Outputs live in a fixed array: no reallocation while enumerating or hot-plugging. Retiring one
+// moves the later outputs down a slot, so refer to outputs by index or HWND, never a held pointer.
+const size_t MAX_OUTPUTS = 32;
+FixedVector<MonitorWindow, MAX_OUTPUTS> g_monitorWindows;
+
+// Per-frame transient memory, reset at the top of every main loop iteration
+const size_t FRAME_ARENA_BYTES = 64 * 1024;
+alignas(16) static unsigned char g_frameArenaStorage[FRAME_ARENA_BYTES];
+FrameArena g_frameArena(g_frameArenaStorage, FRAME_ARENA_BYTES);
+
+// Shared assets
+// CPU-side data is prepared once per process (checker texels with their full mip chain, and the
+// sphere meshes for both geometry modes) and only uploaded per context. Contexts stay unshared.
+// When BoingBallSaver.pak sits next to the .scr it is memory-mapped read-only and used in place
+// (its pages are shared with any other saver or preview process); otherwise everything is generated.
+SharedAssets g_assets;
+
+struct AssetPackMapping {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    const unsigned char* view = nullptr;
 };
 
-std::vector<MonitorWindow> g_monitorWindows;
+AssetPackMapping g_assetPack;
+
+static void UnmapAssetPack() {
+    if (g_assetPack.view) PlaySound(nullptr, nullptr, 0);   // An async sound may still read the view
+    if (g_assetPack.view) { UnmapViewOfFile(g_assetPack.view); g_assetPack.view = nullptr; }
+    if (g_assetPack.mapping) { CloseHandle(g_assetPack.mapping); g_assetPack.mapping = nullptr; }
+    if (g_assetPack.file != INVALID_HANDLE_VALUE) { CloseHandle(g_assetPack.file); g_assetPack.file = INVALID_HANDLE_VALUE; }
+}
 
-// Texture creation (for current context)
-static GLuint MakeCheckerTexture() {
-    const int TEX_SIZE = 128;
+// Map the asset pack from the saver's own directory; false if missing or not for this build
+static bool MapAssetPack(SharedAssets& assets) {
+    wchar_t path[MAX_PATH];
+    DWORD len = GetModuleFileNameW(g_hInst, path, MAX_PATH);
+    if (len == 0 || len >= MAX_PATH) return false;
+    wchar_t* slash = wcsrchr(path, L'\\');
+    if (!slash) return false;
+    slash[1] = L'\0';
+    std::wstring packPath = path;
+    for (const char* c = ASSET_PACK_FILE; *c; ++c) packPath.push_back((wchar_t)*c);
+
+    g_assetPack.file = CreateFileW(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (g_assetPack.file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(g_assetPack.file, &size) || size.QuadPart <= 0 || size.QuadPart > 0x7FFFFFFF) {
+        UnmapAssetPack();
+        return false;
+    }
+
+    g_assetPack.mapping = CreateFileMappingW(g_assetPack.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (g_assetPack.mapping) {
+        g_assetPack.view = (const unsigned char*)MapViewOfFile(g_assetPack.mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!g_assetPack.view || !AttachAssetPack(assets, g_assetPack.view, (size_t)size.QuadPart)) {
+        UnmapAssetPack();
+        return false;
+    }
+    return true;
+}
+
+// Decode the embedded sounds (IMA ADPCM to keep the .scr small) once into playable PCM images
+static void DecodeSoundResource(SharedAssets& assets, int s) {
+    const int ids[SOUND_COUNT] = { BOINGF, BOINGW };
+    if (assets.sound[s].data) return;   // The asset pack already has it as PCM
+    HRSRC res = FindResourceW(g_hInst, MAKEINTRESOURCEW(ids[s]), L"WAVE");
+    HGLOBAL mem = res ? LoadResource(g_hInst, res) : nullptr;
+    const unsigned char* image = mem ? (const unsigned char*)LockResource(mem) : nullptr;
+    if (!image || !DecodeToPcmWave(image, SizeofResource(g_hInst, res), assets.ownedSound[s])) return;
+    assets.sound[s].data = assets.ownedSound[s].data();
+    assets.sound[s].size = (uint32_t)assets.ownedSound[s].size();
+}
+
+static void DecodeSoundResources(SharedAssets& assets) {
+    for (int s = 0; s < SOUND_COUNT; ++s) DecodeSoundResource(assets, s);
+}
+
+// Map or build every shared asset (safe to run on a worker thread: touches no GL and no windows)
+static void PrepareSharedAssets() {
+    if (g_assets.ready) return;
+    if (!MapAssetPack(g_assets)) GenerateSharedAssets(g_assets);
+    if (g_settings.sound) DecodeSoundResources(g_assets);
+    g_assets.ready = true;
+}
+
+// Play a bounce sound from its decoded/packed PCM image, else let PlaySound decode the resource itself
+static void PlayBoingSound(SoundId id) {
+    const SoundView& snd = g_assets.sound[id];
+    if (g_assets.ready && snd.data) {
+        PlaySound((LPCWSTR)snd.data, nullptr, SND_MEMORY | SND_ASYNC);
+    }
+    else {
+        PlaySound(MAKEINTRESOURCE(id == SOUND_FLOOR ? BOINGF : BOINGW), g_hInst, SND_RESOURCE | SND_ASYNC);
+    }
+}
+
+// An asset (re)uploaded to this output's context; a rebuild replaces the asset's previous size
+static void NoteGpuUpload(MonitorWindow& mw, GpuAsset asset, size_t bytes) {
+    mw.gpu.bytes[asset] = bytes;
+    mw.gpu.uploads++;
+}
+
+// GPU bytes an output's context holds, whichever renderer it draws with
+static size_t OutputGpuBytes(const MonitorWindow& mw) {
+    return mw.gpu.Total() + mw.core.GpuBytes();
+}
+
+// Upload the shared checker mip chain level by level on first use (per-context)
+static void EnsureCheckerTexture(MonitorWindow& mw) {
+    if (mw.checkerTex != 0) return;
+    PrepareSharedAssets();
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    unsigned char* data = new unsigned char[TEX_SIZE * TEX_SIZE * 3];
-    for (int y = 0; y < TEX_SIZE; ++y) {
-        for (int x = 0; x < TEX_SIZE; ++x) {
-            int cx = x / (TEX_SIZE / 16), cy = y / (TEX_SIZE / 8);
-            bool red = ((cx + cy) % 2) == 0;
-            unsigned char r = red ? 220 : 240;
-            unsigned char g = red ? 30 : 240;
-            unsigned char b = red ? 30 : 240;
-            int i = (y * TEX_SIZE + x) * 3;
-            data[i] = r; data[i + 1] = g; data[i + 2] = b;
-        }
+
+    glGenTextures(1, &mw.checkerTex);
+    if (mw.checkerTex == 0) return;
+    GLBindTexture2D(mw.glState, mw.checkerTex);
+    for (int level = 0; level < g_assets.checkerLevels; ++level) {
+        const TextureMip& mip = g_assets.checkerMips[level];
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, mip.width, mip.height, 0,
+            GL_RGB, GL_UNSIGNED_BYTE, g_assets.checkerTexels + mip.offset);
     }
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, TEX_SIZE, TEX_SIZE, GL_RGB, GL_UNSIGNED_BYTE, data);
-    delete[] data;
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    return tex;
+    NoteGpuUpload(mw, GPU_CHECKER, CheckerUploadBytes(g_assets));
 }
 
-// Apply viewport/projection and compute per-window bounds
-static void ApplyViewportAndProjection(MonitorWindow& mw, int w, int h) {
+// Compile the ball sphere into a display list for the current geometry mode (per-context)
+// The shared mesh is replayed from vertex arrays once at compile time; each ball or shadow is then one call.
+static void EnsureSphereList(MonitorWindow& mw) {
+    if (mw.sphereList != 0 && mw.sphereListGeometry == g_settings.geometryMode) return;
+    if (mw.sphereList == 0) mw.sphereList = glGenLists(1);
+    if (mw.sphereList == 0) return;
+
+    PrepareSharedAssets();
+    const SphereMeshView& mesh = g_assets.sphere[(g_settings.geometryMode == 1) ? 1 : 0];
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, mesh.positions);
+    glNormalPointer(GL_FLOAT, 0, mesh.normals);
+    glTexCoordPointer(2, GL_FLOAT, 0, mesh.texcoords);
+
+    glNewList(mw.sphereList, GL_COMPILE);
+    glDrawElements(GL_TRIANGLES, (GLsizei)mesh.indexCount, GL_UNSIGNED_SHORT, mesh.indices);
+    glEndList();
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    mw.sphereListGeometry = g_settings.geometryMode;
+    NoteGpuUpload(mw, GPU_SPHERE, SphereUploadBytes(mesh));
+}
+
+// Per-output view cache
+// Viewport, projection and world bounds depend only on the client size, so they are computed when
+// the size changes (WM_SIZE, WM_DPICHANGED, display topology changes) instead of every frame.
+
+// Compute per-window bounds for a client size (CPU only, no context needed). Runs on job threads
+// during setup, so it writes only the output's own fields; callers mark the recorded layout dirty.
+static void ComputeOutputBounds(MonitorWindow& mw, int w, int h) {
     if (w <= 0) w = 1;
     if (h <= 0) h = 1;
 
-    glViewport(0, 0, w, h);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(45.0, (float)w / (float)h, 0.1, 50.0);
+    const WorldBounds bounds = SceneBoundsForSize(w, h);
+    mw.wallX = bounds.wallX;
+    mw.wallZ = bounds.wallZ;
+    mw.floorY = bounds.floorY;
 
-    float fovRadians = 45.0f * (3.14159265f / 180.0f);
-    float camDist = 2.0f;
-    float aspect = (float)w / (float)h;
+    mw.viewW = w;
+    mw.viewH = h;
+    mw.projectionDirty = true;
+    mw.framePresented = false;
+}
 
-    float halfHeight = tanf(fovRadians / 2.0f) * camDist;
-    float halfWidth = halfHeight * aspect;
+// Load the cached viewport/projection into the current context
+static void ApplyOutputProjection(MonitorWindow& mw) {
+    glViewport(0, 0, mw.viewW, mw.viewH);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(SCENE_FOV_Y_DEG, (float)mw.viewW / (float)mw.viewH, SCENE_NEAR, SCENE_FAR);
+    glMatrixMode(GL_MODELVIEW);
+    mw.projectionDirty = false;
+}
 
-    mw.wallX = halfWidth;
-    mw.wallZ = halfWidth;
-    mw.floorY = -halfHeight;
+// Apply viewport/projection and compute per-window bounds
+static void ApplyViewportAndProjection(MonitorWindow& mw, int w, int h) {
+    ComputeOutputBounds(mw, w, h);
+    ApplyOutputProjection(mw);
 }
 
 // Setup GL state for a window/context and compute bounds
 static void SetupGL(MonitorWindow& mw, int w, int h) {
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_TEXTURE_2D);
-
-    glEnable(GL_LIGHTING);
+    // A fresh context: the cache starts from nothing and the first pass sets every cap it uses
+    GLForgetState(mw.glState);
     glEnable(GL_LIGHT0);
-
-    glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glAlphaFunc(GL_GREATER, 0.5f);      // Impostor cut-out
+
+    // Lighting terms come from BoingScene.h (the reference renderer uses the same values); the
+    // light direction is given with an identity modelview, i.e. in eye space
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glLightfv(GL_LIGHT0, GL_POSITION, SCENE_LIGHT_DIR);
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, SCENE_GLOBAL_AMBIENT);
+    glLightfv(GL_LIGHT0, GL_AMBIENT, SCENE_LIGHT_AMBIENT);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, SCENE_LIGHT_DIFFUSE);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, SCENE_MATERIAL_AMBIENT);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, SCENE_MATERIAL_DIFFUSE);
+
+    // Texture and ball sphere from the shared assets, uploaded here so it happens on the setup
+    // job rather than in the first frame
+    EnsureCheckerTexture(mw);
+    EnsureSphereList(mw);
+
+    // Projection and bounds
+    ApplyViewportAndProjection(mw, w, h);
+}
 
-    GLfloat lightDir[] = { -0.5f, 0.8f, 0.6f, 0.0f };
-    glLightfv(GL_LIGHT0, GL_POSITION, lightDir);
+// Telemetry
+// Lightweight counters, reported to the debugger output (DebugView etc.) once per interval.
+const double TELEMETRY_INTERVAL_SEC = 10.0;
+
+struct Telemetry {
+    uint64_t framesRendered = 0;   // Outputs drawn and presented
+    uint64_t framesSkipped = 0;    // Outputs whose inputs were unchanged (no draw, no present)
+    uint64_t loopFrames = 0;       // Main loop iterations
+    uint64_t heapAllocs = 0;       // Heap allocations made during those iterations
+    uint64_t allocFrames = 0;      // Iterations that allocated at all
+    uint64_t particlesEmitted = 0;
+    uint64_t particlesThrottled = 0; // Wanted but cut by the frame budget or a full pool
+    uint64_t particlesPeak = 0;
+    uint64_t particleTicks = 0;    // QueryPerformanceCounter ticks spent updating particles
+    uint64_t framesExported = 0;
+    uint64_t exportSkipped = 0;    // Frames too large for their ring slot, or whose readback failed
+    uint64_t exportTicks = 0;      // Ticks spent reading frames back into the export ring
+    uint64_t contextsLost = 0;     // Contexts that failed to make current or present
+    uint64_t contextsRecovered = 0;
+    uint64_t cpuAtReport = 0;      // Process CPU time (user + kernel, 100 ns units) at the last report
+    LARGE_INTEGER lastReport = {};
+};
+
+Telemetry g_telemetry;
+
+static uint64_t ProcessCpuTime() {
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) return 0;
+    return (((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime) +
+        (((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime);
+}
 
-    GLfloat globalAmbient[] = { 0.3f, 0.3f, 0.3f, 1.0f };
-    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, globalAmbient);
+static void ReportTelemetry() {
+    LARGE_INTEGER now; QueryPerformanceCounter(&now);
+    if (g_telemetry.lastReport.QuadPart == 0) {
+        g_telemetry.lastReport = now;
+        g_telemetry.cpuAtReport = ProcessCpuTime();
+        return;
+    }
+    double elapsed = (double)(now.QuadPart - g_telemetry.lastReport.QuadPart) / (double)g_freq.QuadPart;
+    if (elapsed < TELEMETRY_INTERVAL_SEC) return;
+
+    uint64_t outputs = g_telemetry.framesRendered + g_telemetry.framesSkipped;
+    double skipRate = outputs ? 100.0 * (double)g_telemetry.framesSkipped / (double)outputs : 0.0;
+
+    double allocsPerFrame = g_telemetry.loopFrames ?
+        (double)g_telemetry.heapAllocs / (double)g_telemetry.loopFrames : 0.0;
+
+    double particleUsPerFrame = g_telemetry.loopFrames ?
+        1e6 * (double)g_telemetry.particleTicks / (double)g_freq.QuadPart / (double)g_telemetry.loopFrames : 0.0;
+
+    double exportUsPerFrame = g_telemetry.framesExported ?
+        1e6 * (double)g_telemetry.exportTicks / (double)g_freq.QuadPart / (double)g_telemetry.framesExported : 0.0;
+
+    wchar_t buf[640];
+    swprintf(buf, 640, L"BoingBallSaver: %.1fs rendered=%llu skipped=%llu skip-rate=%.1f%% "
+        L"heap-allocs/frame=%.2f alloc-frames=%llu arena-peak=%llu/%llu arena-overflows=%llu "
+        L"particles-peak=%llu emitted=%llu throttled=%llu particle-us/frame=%.1f "
+        L"exported=%llu export-skipped=%llu export-us/frame=%.1f\n",
+        elapsed, (unsigned long long)g_telemetry.framesRendered,
+        (unsigned long long)g_telemetry.framesSkipped, skipRate, allocsPerFrame,
+        (unsigned long long)g_telemetry.allocFrames, (unsigned long long)g_frameArena.Peak(),
+        (unsigned long long)g_frameArena.Capacity(), (unsigned long long)g_frameArena.Overflows(),
+        (unsigned long long)g_telemetry.particlesPeak, (unsigned long long)g_telemetry.particlesEmitted,
+        (unsigned long long)g_telemetry.particlesThrottled, particleUsPerFrame,
+        (unsigned long long)g_telemetry.framesExported, (unsigned long long)g_telemetry.exportSkipped, exportUsPerFrame);
+    OutputDebugStringW(buf);
+
+    // Job threads: share of the interval each spent running jobs (thread 0 is the main thread)
+    wchar_t jobs[1024];
+    uint64_t jobCount = 0, steals = 0;
+    int len = swprintf(jobs, 1024, L"BoingBallSaver: jobs util");
+    for (unsigned i = 0; i < g_jobs.ThreadCount() && len > 0 && len < 1000; ++i) {
+        JobThreadStats s = g_jobs.TakeStats(i);
+        jobCount += s.jobs;
+        steals += s.steals;
+        len += swprintf(jobs + len, 1024 - len, L" %.1f%%", 1e-7 * (double)s.busyNs / elapsed);
+    }
+    if (len > 0 && len < 1000) {
+        swprintf(jobs + len, 1024 - len, L" threads=%u jobs=%llu stolen=%llu\n", g_jobs.ThreadCount(),
+            (unsigned long long)jobCount, (unsigned long long)steals);
+        OutputDebugStringW(jobs);
+    }
 
-    GLfloat ambient[] = { 0.4f, 0.4f, 0.4f, 1.0f };
-    glLightfv(GL_LIGHT0, GL_AMBIENT, ambient);
+    // GL state calls per drawn frame, and how many the per-context caches dropped as redundant;
+    // outputs on the core renderer report draws and streamed bytes instead
+    uint64_t issued = 0, filtered = 0;
+    unsigned coreOutputs = 0;
+    CoreStats core;
+    for (auto& mw : g_monitorWindows) {
+        issued += mw.glState.issued;
+        filtered += mw.glState.filtered;
+        mw.glState.issued = 0;
+        mw.glState.filtered = 0;
+        if (!mw.core.Ready()) continue;
+        const CoreStats s = mw.core.TakeStats();
+        coreOutputs++;
+        core.frames += s.frames;
+        core.draws += s.draws;
+        core.streamBytes += s.streamBytes;
+        core.fenceWaits += s.fenceWaits;
+        core.uploads += s.uploads;
+    }
+    const double drawn = g_telemetry.framesRendered ? (double)g_telemetry.framesRendered : 1.0;
+    const double coreDrawn = core.frames ? (double)core.frames : 1.0;
+    wchar_t gl[384];
+    swprintf(gl, 384, L"BoingBallSaver: gl state-calls/frame=%.1f filtered/frame=%.1f (%.0f%% redundant) "
+        L"contexts-lost=%llu recovered=%llu core-outputs=%u draws/frame=%.1f stream-kb/frame=%.1f "
+        L"fence-waits=%llu\n", (double)issued / drawn, (double)filtered / drawn,
+        (issued + filtered) ? 100.0 * (double)filtered / (double)(issued + filtered) : 0.0,
+        (unsigned long long)g_telemetry.contextsLost, (unsigned long long)g_telemetry.contextsRecovered,
+        coreOutputs, (double)core.draws / coreDrawn, (double)core.streamBytes / 1024.0 / coreDrawn,
+        (unsigned long long)core.fenceWaits);
+    OutputDebugStringW(gl);
+
+    // GPU assets: what each output's context holds and how many uploads the interval took; the
+    // CPU side is held once in g_assets however many outputs there are
+    wchar_t gpu[1024];
+    size_t gpuTotal = 0;
+    uint64_t uploads = core.uploads;
+    len = swprintf(gpu, 1024, L"BoingBallSaver: gpu-kb per output");
+    for (auto& mw : g_monitorWindows) {
+        const size_t bytes = OutputGpuBytes(mw);
+        gpuTotal += bytes;
+        uploads += mw.gpu.uploads;
+        mw.gpu.uploads = 0;
+        if (len > 0 && len < 1000) len += swprintf(gpu + len, 1024 - len, L" %.1f", (double)bytes / 1024.0);
+    }
+    if (len > 0 && len < 1000) {
+        swprintf(gpu + len, 1024 - len, L" total=%.1f uploads=%llu\n", (double)gpuTotal / 1024.0,
+            (unsigned long long)uploads);
+        OutputDebugStringW(gpu);
+    }
 
-    // Texture (create per-context)
-    mw.checkerTex = MakeCheckerTexture();
-    glBindTexture(GL_TEXTURE_2D, mw.checkerTex);
+    // Power: the cadence now, what the main thread's wakeups and the whole process's CPU cost
+    const uint64_t cpu = ProcessCpuTime();
+    const PacingCadence cadence = ChooseCadence(g_power, g_settings.lowPower);
+    wchar_t power[256];
+    swprintf(power, 256, L"BoingBallSaver: power cadence=%hs fps=%u cpu-ms/min=%.0f wakeups/s=%.1f "
+        L"(%.1f for messages) frames/s=%.1f display=%hs battery=%d\n", CadenceName(cadence), g_pacer.Fps(cadence),
+        CpuMsPerMinute((cpu - g_telemetry.cpuAtReport) * 100, elapsed), PerSecond(g_powerCounters.wakeups, elapsed),
+        PerSecond(g_powerCounters.messageWakeups, elapsed), PerSecond(g_powerCounters.frames, elapsed),
+        !g_power.displayOn ? "off" : (g_power.displayDimmed ? "dimmed" : "on"), g_power.onBattery ? 1 : 0);
+    OutputDebugStringW(power);
+    g_telemetry.cpuAtReport = cpu;
+    g_powerCounters = PowerCounters();
+
+    g_telemetry.framesRendered = 0;
+    g_telemetry.framesSkipped = 0;
+    g_telemetry.loopFrames = 0;
+    g_telemetry.heapAllocs = 0;
+    g_telemetry.allocFrames = 0;
+    g_telemetry.particlesEmitted = 0;
+    g_telemetry.particlesThrottled = 0;
+    g_telemetry.particlesPeak = 0;
+    g_telemetry.particleTicks = 0;
+    g_telemetry.framesExported = 0;
+    g_telemetry.exportSkipped = 0;
+    g_telemetry.exportTicks = 0;
+    g_frameArena.ResetStats();
+    g_telemetry.lastReport = now;
+}
 
-    // Quadric (per-context)
-    mw.quadric = gluNewQuadric();
-    gluQuadricTexture(mw.quadric, GL_TRUE);
-    gluQuadricNormals(mw.quadric, GLU_SMOOTH);
+// Frame allocation accounting
+// Frames after the warm-up must not touch the heap; known one-off rebuilds (preview cache, display
+// changes) restart the warm-up instead of tripping the check.
+const uint64_t HEAP_WARMUP_FRAMES = 120;
 
-    // Projection and bounds
-    ApplyViewportAndProjection(mw, w, h);
+struct FrameAllocations {
+    uint64_t atFrameStart = 0;
+    uint64_t steadyFrames = 0;     // Frames since start or the last expected allocation burst
+};
+
+FrameAllocations g_frameAllocs;
+
+static void NoteExpectedAllocations() {
+    g_frameAllocs.steadyFrames = 0;
+}
+
+static void BeginFrameAllocations() {
+    g_frameArena.Reset();
+    g_frameAllocs.atFrameStart = g_heapAllocs.load(std::memory_order_relaxed);
+}
+
+static void EndFrameAllocations() {
+    uint64_t allocs = g_heapAllocs.load(std::memory_order_relaxed) - g_frameAllocs.atFrameStart;
+    g_telemetry.loopFrames++;
+    g_telemetry.heapAllocs += allocs;
+    if (allocs) g_telemetry.allocFrames++;
+
+    // Steady state is allocation-free (debug builds stop here if that regresses)
+    if (g_frameAllocs.steadyFrames >= HEAP_WARMUP_FRAMES) assert(allocs == 0);
+    g_frameAllocs.steadyFrames++;
+}
+
+// Startup timeline
+// Marks each startup phase up to the first presented frame and reports the breakdown once to the
+// debugger output, so slow starts on many-panel walls can be attributed.
+enum StartupPhase {
+    STARTUP_SETTINGS = 0,   // Settings snapshot loaded
+    STARTUP_WINDOWS,        // Every output window created (asset prep runs alongside)
+    STARTUP_ASSETS,         // Shared asset worker joined
+    STARTUP_CONTEXTS,       // Every output's GL context and resources ready
+    STARTUP_FIRST_FRAME,    // First frame presented
+    STARTUP_PHASE_COUNT
+};
+
+struct StartupTimeline {
+    LARGE_INTEGER freq = {};
+    LARGE_INTEGER start = {};
+    LARGE_INTEGER marks[STARTUP_PHASE_COUNT] = {};
+    double assetsMs = 0.0;          // From queueing the asset jobs to the last one finishing
+    bool   reported = false;
+};
+
+StartupTimeline g_startup;
+
+static void StartupBegin() {
+    QueryPerformanceFrequency(&g_startup.freq);
+    QueryPerformanceCounter(&g_startup.start);
+}
+
+static void StartupMark(StartupPhase phase) {
+    QueryPerformanceCounter(&g_startup.marks[phase]);
+}
+
+static double StartupMs(const LARGE_INTEGER& from, const LARGE_INTEGER& to) {
+    if (g_startup.freq.QuadPart == 0 || to.QuadPart == 0) return 0.0;
+    return 1000.0 * (double)(to.QuadPart - from.QuadPart) / (double)g_startup.freq.QuadPart;
+}
+
+static void ReportStartupTimeline() {
+    if (g_startup.reported) return;
+    g_startup.reported = true;
+    StartupMark(STARTUP_FIRST_FRAME);
+
+    const LARGE_INTEGER* m = g_startup.marks;
+    double slowest = 0.0;
+    for (const auto& mw : g_monitorWindows) slowest = (std::max)(slowest, mw.setupMs);
+
+    wchar_t buf[512];
+    swprintf(buf, 512,
+        L"BoingBallSaver startup: settings %.1f ms, windows %.1f ms, assets wait %.1f ms (jobs %.1f ms), "
+        L"contexts %.1f ms (%d outputs, slowest %.1f ms), first frame %.1f ms, total %.1f ms\n",
+        StartupMs(g_startup.start, m[STARTUP_SETTINGS]),
+        StartupMs(m[STARTUP_SETTINGS], m[STARTUP_WINDOWS]),
+        StartupMs(m[STARTUP_WINDOWS], m[STARTUP_ASSETS]), g_startup.assetsMs,
+        StartupMs(m[STARTUP_ASSETS], m[STARTUP_CONTEXTS]), (int)g_monitorWindows.size(), slowest,
+        StartupMs(m[STARTUP_CONTEXTS], m[STARTUP_FIRST_FRAME]),
+        StartupMs(g_startup.start, m[STARTUP_FIRST_FRAME]));
+    OutputDebugStringW(buf);
+}
+
+// Shared asset preparation runs as jobs while the windows are being created: the root maps the
+// pack or fans out one generator per asset, sounds decode alongside, and a continuation marks
+// the whole graph done
+static Job*          g_assetsDone = nullptr;
+static LARGE_INTEGER g_assetsQueued;
+
+static void StartAssetPreparation() {
+    QueryPerformanceCounter(&g_assetsQueued);
+    Job* root = g_jobs.Create([](Job* self) {
+        if (!MapAssetPack(g_assets)) {
+            g_assets.fromPack = false;
+            g_jobs.Run(g_jobs.Create([](Job*) { GenerateCheckerAsset(g_assets); }, self));
+            for (int lod = 0; lod < 2; ++lod) {
+                g_jobs.Run(g_jobs.Create([lod](Job*) { GenerateSphereAsset(g_assets, lod); }, self));
+            }
+        }
+        if (g_settings.sound) {
+            for (int s = 0; s < SOUND_COUNT; ++s) {
+                g_jobs.Run(g_jobs.Create([s](Job*) { DecodeSoundResource(g_assets, s); }, self));
+            }
+        }
+    });
+    g_assetsDone = g_jobs.Create([](Job*) {
+        LARGE_INTEGER t1;
+        QueryPerformanceCounter(&t1);
+        g_startup.assetsMs = StartupMs(g_assetsQueued, t1);
+        g_assets.ready = true;
+    });
+    g_jobs.AddContinuation(root, g_assetsDone);
+    g_jobs.Run(root);
+}
+
+static void FinishAssetPreparation() {
+    if (g_assetsDone) {
+        g_jobs.Wait(g_assetsDone);   // The main thread helps with whatever is left
+        g_assetsDone = nullptr;
+    }
+    PrepareSharedAssets();   // No-op once the jobs have run
+}
+
+// Frame export (optional)
+// Every presented frame is read back straight into a slot of a named shared-memory ring, one ring
+// per output ("Local\BoingBallSaverFrames<n>", layout in BoingExport.h). Consumers read in place
+// and check the slot's sequence afterwards; the saver never waits for them. Frames skipped because
+// nothing changed are not exported again, so consumers keep showing the newest one.
+static uint64_t QpcToNs(LONGLONG ticks) {
+    const uint64_t t = (uint64_t)ticks, f = (uint64_t)g_freq.QuadPart;
+    return (t / f) * 1000000000ull + (t % f) * 1000000000ull / f;
+}
+
+static void OpenFrameExport(MonitorWindow& mw) {
+    if (!g_settings.frameExport || g_preview || mw.exporter.IsAttached()) return;
+
+    // Lowest number no other output holds, so outputs that survive a rebuild keep their names
+    int index = 0;
+    for (bool taken = true; taken;) {
+        taken = false;
+        for (const auto& other : g_monitorWindows) {
+            if (other.exportIndex == index) { taken = true; ++index; break; }
+        }
+    }
+
+    const uint32_t slots = (std::min)((std::max)(g_settings.frameExport, EXPORT_MIN_SLOTS), EXPORT_MAX_SLOTS);
+    const uint64_t capacity = 4ull * (uint64_t)(mw.monitorRect.right - mw.monitorRect.left) *
+        (uint64_t)(mw.monitorRect.bottom - mw.monitorRect.top);
+    const uint64_t bytes = ExportRingBytes(slots, capacity);
+    wchar_t name[64];
+    swprintf(name, 64, L"Local\\%hs%d", EXPORT_RING_NAME, index);
+
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)(bytes >> 32), (DWORD)bytes, name);
+    if (!mapping) return;
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)bytes);
+    if (!view || !mw.exporter.Attach(view, bytes, slots, capacity, GetCurrentProcessId())) {
+        if (view) UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        return;
+    }
+    mw.exportMapping = mapping;
+    mw.exportIndex = index;
+}
+
+static void OpenFrameExports() {
+    for (auto& mw : g_monitorWindows) OpenFrameExport(mw);
+}
+
+static void CloseFrameExport(MonitorWindow& mw) {
+    if (mw.exporter.IsAttached()) UnmapViewOfFile(mw.exporter.Base());
+    mw.exporter.Detach();
+    if (mw.exportMapping) { CloseHandle(mw.exportMapping); mw.exportMapping = nullptr; }
+    mw.exportIndex = -1;
+}
+
+// Read the finished back buffer into the next ring slot (context current, before SwapBuffers)
+static void ExportFrame(MonitorWindow& mw) {
+    if (!mw.exporter.IsAttached() || mw.viewW <= 0 || mw.viewH <= 0) return;
+    LARGE_INTEGER t0, t1;
+    QueryPerformanceCounter(&t0);
+    const uint32_t w = (uint32_t)mw.viewW, h = (uint32_t)mw.viewH;
+    unsigned char* pixels = mw.exporter.BeginFrame(w, h, w * 4, EXPORT_FORMAT_BGRA8, EXPORT_FLAG_BOTTOM_UP,
+        QpcToNs(g_prev.QuadPart));   // The frame shows the scene as of this loop iteration's time sample
+    if (!pixels) { g_telemetry.exportSkipped++; return; }
+
+    glGetError();
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, (GLsizei)w, (GLsizei)h, GL_BGRA_EXT, GL_UNSIGNED_BYTE, pixels);
+    QueryPerformanceCounter(&t1);
+    if (glGetError() != GL_NO_ERROR) {
+        mw.exporter.Cancel();
+        g_telemetry.exportSkipped++;
+        return;
+    }
+    mw.exporter.Publish(QpcToNs(t1.QuadPart));
+    g_telemetry.framesExported++;
+    g_telemetry.exportTicks += (uint64_t)(t1.QuadPart - t0.QuadPart);
+}
+
+// Core-profile renderer
+// Entry points come from wglGetProcAddress, which returns nothing (or 1, 2, 3, -1 on some
+// drivers) for the GL 1.1 functions opengl32.dll exports itself
+static void* GetGLProc(const char* name) {
+    void* p = (void*)wglGetProcAddress(name);
+    const intptr_t v = (intptr_t)p;
+    if (v == 0 || v == 1 || v == 2 || v == 3 || v == -1) {
+        static HMODULE opengl32 = GetModuleHandleW(L"opengl32.dll");
+        p = opengl32 ? (void*)GetProcAddress(opengl32, name) : nullptr;
+    }
+    return p;
+}
+
+// Swap the window's legacy context (current on entry) for a GL 3.3 core one running the shader
+// renderer. Anything missing keeps the legacy context and the fixed-function path. The preview
+// stays fixed function: its blit into the host window uses glDrawPixels.
+static bool TryCoreContext(MonitorWindow& mw) {
+    if (g_settings.renderer != RENDERER_AUTO || g_preview) return false;
+
+    typedef HGLRC (WINAPI* CreateContextAttribsFn)(HDC, HGLRC, const int*);
+    CreateContextAttribsFn createContextAttribs =
+        (CreateContextAttribsFn)wglGetProcAddress("wglCreateContextAttribsARB");
+    if (!createContextAttribs) {
+        OutputDebugStringA("BoingBallSaver: no WGL_ARB_create_context, fixed-function renderer\n");
+        return false;
+    }
+    const int attribs[] = {
+        0x2091, CORE_GL_MAJOR,      // WGL_CONTEXT_MAJOR_VERSION_ARB
+        0x2092, CORE_GL_MINOR,      // WGL_CONTEXT_MINOR_VERSION_ARB
+        0x9126, 0x00000001,         // WGL_CONTEXT_PROFILE_MASK_ARB: WGL_CONTEXT_CORE_PROFILE_BIT_ARB
+        0
+    };
+    HGLRC core = createContextAttribs(mw.hDC, nullptr, attribs);
+    if (!core) {
+        OutputDebugStringA("BoingBallSaver: no GL 3.3 core context, fixed-function renderer\n");
+        return false;
+    }
+    if (!wglMakeCurrent(mw.hDC, core) || !mw.core.Init(GetGLProc, g_assets)) {
+        char msg[600];
+        snprintf(msg, sizeof(msg), "BoingBallSaver: core renderer unavailable (%s), fixed-function renderer\n",
+            mw.core.Error()[0] ? mw.core.Error() : "cannot make current");
+        OutputDebugStringA(msg);
+        wglMakeCurrent(mw.hDC, mw.hGL);
+        wglDeleteContext(core);     // Takes whatever Init created with it
+        mw.core.Forget();
+        return false;
+    }
+
+    OutputDebugStringA(mw.core.Persistent() ? "BoingBallSaver: core renderer, persistent-mapped buffer\n" :
+        "BoingBallSaver: core renderer, staged uploads\n");
+    wglDeleteContext(mw.hGL);
+    mw.hGL = core;
+    return true;
+}
+
+// Create one output's GL context and per-context resources (runs on any job thread)
+static bool SetupOutputContext(MonitorWindow& mw) {
+    LARGE_INTEGER t0, t1;
+    QueryPerformanceCounter(&t0);
+
+    mw.hGL = wglCreateContext(mw.hDC);
+    if (!mw.hGL) return false;
+    if (!wglMakeCurrent(mw.hDC, mw.hGL)) {
+        wglDeleteContext(mw.hGL);
+        mw.hGL = nullptr;
+        return false;
+    }
+
+    // Setup GL and resources per window (texture + sphere list + projection); the core renderer
+    // builds its own on first draw and only needs the bounds. A recovered context keeps the size
+    // the window was last resized to; only the first setup starts from the monitor rectangle.
+    int w = mw.viewW, h = mw.viewH;
+    if (w <= 0 || h <= 0) {
+        w = mw.monitorRect.right - mw.monitorRect.left;
+        h = mw.monitorRect.bottom - mw.monitorRect.top;
+    }
+    if (TryCoreContext(mw)) ComputeOutputBounds(mw, w, h);
+    else                    SetupGL(mw, w, h);
+
+    // Release so the render loop can make it current on the main thread
+    wglMakeCurrent(NULL, NULL);
+
+    QueryPerformanceCounter(&t1);
+    mw.setupMs = StartupMs(t0, t1);
+    return true;
+}
+
+// Drop every per-context handle without deleting (the objects are gone with their context)
+static void ForgetOutputGpu(MonitorWindow& mw) {
+    mw.checkerTex = 0;
+    mw.sphereList = 0;
+    mw.sphereListGeometry = -1;
+    mw.gridList = 0;
+    mw.impostorTex = 0;
+    mw.impostorCell = 0;
+    for (size_t& b : mw.gpu.bytes) b = 0;
+    mw.core.Forget();
+}
+
+// Delete every per-context object (the output's context must be current)
+static void ReleaseOutputGpu(MonitorWindow& mw) {
+    if (mw.checkerTex) glDeleteTextures(1, &mw.checkerTex);
+    if (mw.impostorTex) glDeleteTextures(1, &mw.impostorTex);
+    if (mw.sphereList) glDeleteLists(mw.sphereList, 1);
+    if (mw.gridList) glDeleteLists(mw.gridList, 1);
+    mw.core.Release();
+    ForgetOutputGpu(mw);
+}
+
+// A context that stopped working (driver reset, device removed): its objects died with it, so the
+// handles are dropped without deleting them and the whole context is rebuilt before the next draw
+static void NoteContextLost(MonitorWindow& mw) {
+    g_telemetry.contextsLost++;
+    wglMakeCurrent(NULL, NULL);
+    if (mw.hGL) wglDeleteContext(mw.hGL);
+    mw.hGL = nullptr;
+    ForgetOutputGpu(mw);
+    GLForgetState(mw.glState);
+    mw.projectionDirty = true;
+    mw.framePresented = false;
+    mw.contextRetryAt = 0;
+}
+
+// Give a window whose context was lost a new one (current on return); a failed attempt is retried
+// at most once a second
+static bool RecoverOutputContext(MonitorWindow& mw) {
+    if (mw.hGL) NoteContextLost(mw);     // The handle is still there but no longer makes current
+    const ULONGLONG now = GetTickCount64();
+    if (!mw.hDC || now < mw.contextRetryAt) return false;
+    if (!SetupOutputContext(mw)) {
+        mw.contextRetryAt = now + 1000;
+        return false;
+    }
+    if (!wglMakeCurrent(mw.hDC, mw.hGL)) {
+        wglDeleteContext(mw.hGL);
+        mw.hGL = nullptr;
+        mw.contextRetryAt = now + 1000;
+        return false;
+    }
+    g_recordLayoutDirty = true;
+    g_telemetry.contextsRecovered++;
+    return true;
+}
+
+// Release one output's resources, context, DC and window
+static void ReleaseOutput(MonitorWindow& mw) {
+    CloseFrameExport(mw);
+    if (mw.hDC && mw.hGL && wglMakeCurrent(mw.hDC, mw.hGL)) {
+        ReleaseOutputGpu(mw);
+        wglMakeCurrent(NULL, NULL);
+    }
+    else {
+        ForgetOutputGpu(mw);     // Cannot delete them; they go with the context
+    }
+    if (mw.hGL) { wglDeleteContext(mw.hGL); mw.hGL = nullptr; }
+    if (mw.hDC) { ReleaseDC(mw.hWnd, mw.hDC); mw.hDC = nullptr; }
+    if (mw.hWnd) { DestroyWindow(mw.hWnd); mw.hWnd = nullptr; }
+}
+
+// Set up every created output, one job per output so context creation overlaps
+// Windows and DCs are created on the main thread (it owns the message queue); only the
+// GL work is spread out. Outputs whose context fails are dropped.
+static void SetupOutputsParallel() {
+    StartupMark(STARTUP_WINDOWS);
+    FinishAssetPreparation();
+    StartupMark(STARTUP_ASSETS);
+
+    const size_t n = g_monitorWindows.size();
+    std::vector<char> ok(n, 0);
+    char* okFlags = ok.data();
+    g_jobs.ParallelFor(n, 1, [okFlags](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) okFlags[i] = SetupOutputContext(g_monitorWindows[i]) ? 1 : 0;
+    });
+    g_recordLayoutDirty = true;   // Bounds were computed on the jobs
+
+    // A failed output is retired alone: the others keep running
+    g_retiringOutput = true;
+    for (size_t i = n; i-- > 0;) {
+        if (ok[i]) continue;
+        MonitorWindow& mw = g_monitorWindows[i];
+        if (g_hWnd == mw.hWnd) g_hWnd = nullptr;
+        ReleaseOutput(mw);
+        g_monitorWindows.erase(g_monitorWindows.begin() + i);
+    }
+    g_retiringOutput = false;
+    if (!g_hWnd && !g_monitorWindows.empty()) g_hWnd = g_monitorWindows[0].hWnd;
+    OpenFrameExports();
+
+    StartupMark(STARTUP_CONTEXTS);
 }
 
 // Initialize high-resolution timer
@@ -405,261 +1232,939 @@ static float ComputeDeltaTime() {
     LARGE_INTEGER now; QueryPerformanceCounter(&now);
     float dt = (float)(now.QuadPart - g_prev.QuadPart) / (float)g_freq.QuadPart;
     g_prev = now;
-    if (dt > 0.05f) dt = 0.05f;
+    if (dt > PACING_MAX_STEP) dt = PACING_MAX_STEP;
     return dt;
 }
 
-// Global physics helpers (use global bounds)
-static inline void reflectXAtWallGlobal() {
-    if (g_ballX > g_WALL_X - BALL_RADIUS) {
-        g_ballX = g_WALL_X - BALL_RADIUS;
-        g_vx = -fabsf(g_vx);
-        g_spinDir *= -1;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGW), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
-        }
+// Frame pacing
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// Display and power source notifications; the system sends the current values on registration
+static const GUID POWER_CONSOLE_DISPLAY_STATE =
+    { 0x6fe69556, 0x704a, 0x47a0, { 0x8f, 0x24, 0xc2, 0x8d, 0x93, 0x6f, 0xda, 0x47 } };
+static const GUID POWER_ACDC_POWER_SOURCE =
+    { 0x5d3e9a59, 0xe9d5, 0x4b00, { 0xa6, 0xbd, 0xff, 0x34, 0xff, 0x51, 0x65, 0x48 } };
+
+HWND         g_powerWindow = nullptr;   // Window the notifications are registered on
+HPOWERNOTIFY g_powerNotify[2] = {};
+
+static void UnwatchPowerState() {
+    for (HPOWERNOTIFY& h : g_powerNotify) {
+        if (h) UnregisterPowerSettingNotification(h);
+        h = nullptr;
     }
-    else if (g_ballX < -g_WALL_X + BALL_RADIUS) {
-        g_ballX = -g_WALL_X + BALL_RADIUS;
-        g_vx = +fabsf(g_vx);
-        g_spinDir *= -1;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGW), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
-        }
+    g_powerWindow = nullptr;
+}
+
+// (Re)register on the primary window, which a display change may have replaced
+static void WatchPowerState() {
+    if (g_preview || g_powerWindow == g_hWnd) return;
+    UnwatchPowerState();
+    if (!g_hWnd) return;
+    g_powerNotify[0] = RegisterPowerSettingNotification(g_hWnd, &POWER_CONSOLE_DISPLAY_STATE, DEVICE_NOTIFY_WINDOW_HANDLE);
+    g_powerNotify[1] = RegisterPowerSettingNotification(g_hWnd, &POWER_ACDC_POWER_SOURCE, DEVICE_NOTIFY_WINDOW_HANDLE);
+    g_powerWindow = g_hWnd;
+}
+
+static void OnPowerSettingChange(const POWERBROADCAST_SETTING* s) {
+    if (!s || s->DataLength < sizeof(DWORD)) return;
+    DWORD v = 0;
+    memcpy(&v, s->Data, sizeof(v));
+    if (IsEqualGUID(s->PowerSetting, POWER_CONSOLE_DISPLAY_STATE)) {
+        g_power.displayOn = (v != 0);          // 0 = off, 1 = on, 2 = dimmed
+        g_power.displayDimmed = (v == 2);
+    }
+    else if (IsEqualGUID(s->PowerSetting, POWER_ACDC_POWER_SOURCE)) {
+        g_power.onBattery = (v != 0);          // 0 = AC, 1 = battery, 2 = short-term (UPS)
     }
 }
 
-static void UpdatePhysicsGlobal(float dt) {
-    g_spinAngle += g_spinDir * g_spinSpeed * dt;
-    if (g_spinAngle > 360.0f) g_spinAngle -= 360.0f;
-    if (g_spinAngle < 0.0f)   g_spinAngle += 360.0f;
-
-    g_vy += GRAVITY * dt;
-    g_ballX += g_vx * dt;
-    g_ballY += g_vy * dt;
-    g_ballZ += g_vz * dt;
-
-    if (g_ballY < g_FLOOR_Y + BALL_RADIUS) {
-        g_ballY = g_FLOOR_Y + BALL_RADIUS;
-        g_vy = 4.5f;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGF), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
+// Highest refresh rate among the outputs (0 when the driver only reports its default)
+static uint32_t DisplayRefreshHz() {
+    int hz = 0;
+    for (auto& mw : g_monitorWindows) {
+        const int r = mw.hDC ? GetDeviceCaps(mw.hDC, VREFRESH) : 0;
+        if (r > hz) hz = r;
+    }
+    return hz > 1 ? (uint32_t)hz : 0;
+}
+
+static void ConfigurePacing() {
+    g_pacer.Configure(g_settings.frameRateCap, DisplayRefreshHz());
+}
+
+static void StartPacing() {
+    g_frameTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!g_frameTimer) g_frameTimer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);   // Before Windows 10 1803
+    g_idleTimer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    ConfigurePacing();
+    WatchPowerState();
+    QueryPerformanceCounter(&g_wakeAt);
+}
+
+static void StopPacing() {
+    UnwatchPowerState();
+    if (g_frameTimer) { CloseHandle(g_frameTimer); g_frameTimer = nullptr; }
+    if (g_idleTimer) { CloseHandle(g_idleTimer); g_idleTimer = nullptr; }
+}
+
+static void PumpMessages() {
+    MSG msg;
+    while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) g_running = false;
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+}
+
+// Sleep until the next frame is due, handling window messages as they arrive. Returns early when
+// a message asks for the loop: quit, a display change, or a power change that moves the cadence.
+static void WaitForNextFrame(PacingCadence cadence) {
+    LARGE_INTEGER now; QueryPerformanceCounter(&now);
+    g_frameWorkMs = (float)((double)(now.QuadPart - g_wakeAt.QuadPart) * 1000.0 / (double)g_freq.QuadPart);
+
+    const uint64_t deadline = g_pacer.NextDeadline(QpcToNs(now.QuadPart), cadence);
+    HANDLE timer = (cadence == CADENCE_FULL) ? g_frameTimer : g_idleTimer;
+    const ULONG toleranceMs = (ULONG)(g_pacer.ToleranceNs(cadence) / 1000000);
+    for (;;) {
+        const uint64_t nowNs = QpcToNs(now.QuadPart);
+        if (nowNs >= deadline) break;
+        LARGE_INTEGER due; due.QuadPart = -(LONGLONG)((deadline - nowNs) / 100);   // Relative, 100 ns units
+        const bool timed = timer && SetWaitableTimerEx(timer, &due, 0, nullptr, nullptr, nullptr, toleranceMs);
+        const DWORD r = timed ?
+            MsgWaitForMultipleObjectsEx(1, &timer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE) :
+            MsgWaitForMultipleObjectsEx(0, nullptr, (DWORD)((deadline - nowNs + 999999) / 1000000), QS_ALLINPUT,
+                MWMO_INPUTAVAILABLE);
+        g_powerCounters.wakeups++;
+        if (r != WAIT_OBJECT_0 + (timed ? 1u : 0u)) break;     // Timer (or timeout): the frame is due
+        g_powerCounters.messageWakeups++;
+        PumpMessages();
+        if (!g_running || g_displayChanged || ChooseCadence(g_power, g_settings.lowPower) != cadence) break;
+        QueryPerformanceCounter(&now);
+    }
+    QueryPerformanceCounter(&g_wakeAt);
+}
+
+// Position of an output in g_monitorWindows (its ball and particle world in per-output modes)
+static size_t OutputIndex(const MonitorWindow& mw) {
+    return (size_t)(&mw - g_monitorWindows.begin());
+}
+
+// Simulation parameters as the saver runs them (also stamped into recordings)
+static SimParams CurrentSimParams() {
+    SimParams p;
+    p.radius = BALL_RADIUS;
+    p.gravity = GRAVITY;
+    p.spinSpeed = g_spinSpeed;
+    p.bounceVy = 4.5f;
+    return p;
+}
+
+// Run recording (/record <file>)
+// Balls are numbered as the main loop steps them: the global ball alone in Single, Replicated and
+// Spanned, otherwise one per output in window order.
+static bool UsesGlobalBall() {
+    return g_settings.multiMonitorMode == 0 || g_settings.multiMonitorMode == 2 || g_settings.multiMonitorMode == 4;
+}
+
+static void RecordTick(float simDt) {
+    if (!g_recorder.IsOpen()) return;
+    if (g_recordLayoutDirty) {
+        BallState balls[MAX_OUTPUTS];
+        WorldBounds bounds[MAX_OUTPUTS];
+        size_t count = 0;
+        if (UsesGlobalBall()) {
+            balls[0] = g_ball;
+            bounds[0] = { g_WALL_X, g_WALL_Z, g_FLOOR_Y };
+            count = 1;
+        }
+        else {
+            for (const auto& mw : g_monitorWindows) {
+                balls[count] = mw.ball;
+                bounds[count] = { mw.wallX, mw.wallZ, mw.floorY };
+                ++count;
+            }
         }
+        g_recorder.Layout(count, balls, bounds, !g_recordLayoutFresh);
+        g_recordLayoutDirty = false;
+        g_recordLayoutFresh = false;
     }
+    g_recorder.Tick(simDt);
+}
+
+// At most one bounce sound per frame: the first impact of the step picks floor or wall
+static void PlayImpactSound(const SimImpacts& impacts) {
+    if (!g_settings.sound || g_soundPlayedThisFrame || impacts.count == 0) return;
+    PlayBoingSound((impacts.list[0].event & SIM_EVENT_FLOOR) ? SOUND_FLOOR : SOUND_WALL);
+    g_soundPlayedThisFrame = true;
+}
 
-    reflectXAtWallGlobal();
+// Impact particles (optional)
+// One pool for every world (world = ball index, as in recordings), advanced once per main loop
+// iteration and drawn by each output after its balls. Emission backs off as frames run long.
+const float    PARTICLE_FRAME_BUDGET_MS = 33.3f;   // Full emission up to half of this, none at it
+const size_t   PARTICLES_PER_FLOOR_HIT = 48;
+const size_t   PARTICLES_PER_WALL_HIT = 32;
+const uint32_t PARTICLE_DUST_COLOR = 0x00B8C8D0;    // COLORREF layout
+const uint32_t PARTICLE_SPARK_COLOR = 0x0080E0FF;
+const size_t   PARTICLE_JOB_CHUNK = 1024;          // Particles integrated per job (multiple of 4)
+const size_t   PARTICLE_PARALLEL_MIN = 2048;       // Below this, handing out jobs costs more than it saves
+
+ParticlePool     g_particles;
+ParticleThrottle g_particleThrottle(PARTICLE_FRAME_BUDGET_MS);
+
+static void EmitImpactParticles(size_t world, const SimImpacts& impacts, const WorldBounds& bounds) {
+    if (!g_settings.impactParticles) return;
+    for (int i = 0; i < impacts.count; ++i) {
+        const SimImpact& im = impacts.list[i];
+        size_t wanted = 0, emitted = 0;
+        if (im.event & SIM_EVENT_FLOOR) {
+            // Dust kicked up around the contact point
+            wanted = PARTICLES_PER_FLOOR_HIT;
+            emitted = g_particles.Emit(world, im.x, bounds.floorY, im.z, 0.0f, 1.0f, 0.0f, 1.2f,
+                bounds.floorY, PARTICLE_DUST_COLOR, g_particleThrottle.Throttle(wanted));
+        }
+        else {
+            // Sparkles off the side wall the ball touched
+            const float side = (im.x > 0.0f) ? 1.0f : -1.0f;
+            wanted = PARTICLES_PER_WALL_HIT;
+            emitted = g_particles.Emit(world, im.x + side * BALL_RADIUS, im.y, im.z, -side, 0.3f, 0.0f, 1.6f,
+                bounds.floorY, PARTICLE_SPARK_COLOR, g_particleThrottle.Throttle(wanted));
+        }
+        g_telemetry.particlesEmitted += emitted;
+        g_telemetry.particlesThrottled += wanted - emitted;
+    }
+}
 
-    if (g_ballZ > g_WALL_Z - BALL_RADIUS) {
-        g_ballZ = g_WALL_Z - BALL_RADIUS;
-        g_vz = -fabsf(g_vz);
+static void UpdateParticles(float dt) {
+    if (!g_settings.impactParticles) return;
+    LARGE_INTEGER t0, t1;
+    QueryPerformanceCounter(&t0);
+    const size_t live = g_particles.Live();
+    if (live >= PARTICLE_PARALLEL_MIN && g_jobs.ThreadCount() > 1) {
+        // Integrate in chunks across the job threads, then compact and pack on this one
+        g_jobs.ParallelFor((live + PARTICLE_JOB_CHUNK - 1) / PARTICLE_JOB_CHUNK, 1, [live, dt](size_t begin, size_t end) {
+            g_particles.Integrate(begin * PARTICLE_JOB_CHUNK, (std::min)(end * PARTICLE_JOB_CHUNK, live), dt, GRAVITY);
+        });
+        g_particles.FinishUpdate();
     }
-    else if (g_ballZ < -g_WALL_Z + BALL_RADIUS) {
-        g_ballZ = -g_WALL_Z + BALL_RADIUS;
-        g_vz = +fabsf(g_vz);
+    else {
+        g_particles.Update(dt, GRAVITY);
     }
+    QueryPerformanceCounter(&t1);
+    g_telemetry.particleTicks += (uint64_t)(t1.QuadPart - t0.QuadPart);
+    if (g_particles.Live() > g_telemetry.particlesPeak) g_telemetry.particlesPeak = g_particles.Live();
+}
+
+// Draw one world's particles as blended points (no depth writes), in this output's view of the world
+static void DrawParticles(MonitorWindow& mw, size_t world, float worldOffsetX) {
+    const size_t count = g_particles.LiveIn(world);
+    if (count == 0) return;
+
+    GLStateCache& gs = mw.glState;
+    GLLoadCamera(gs, worldOffsetX);
+    GLApplyCaps(gs, GLCAP_DEPTH_TEST | GLCAP_BLEND);
+    GLSetPointSize(gs, SCENE_PARTICLE_POINT_SIZE);
+
+    glInterleavedArrays(GL_C4UB_V3F, 0, g_particles.VerticesOf(world));
+    glDrawArrays(GL_POINTS, 0, (GLsizei)count);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    gs.colorKnown = false;      // The color array left the current color undefined
+}
+
+// Global physics (use global bounds)
+static void UpdatePhysicsGlobal(float dt) {
+    const WorldBounds bounds = { g_WALL_X, g_WALL_Z, g_FLOOR_Y };
+    SimImpacts impacts;
+    StepBall(g_ball, bounds, CurrentSimParams(), dt, &impacts);
+    PlayImpactSound(impacts);
+    EmitImpactParticles(0, impacts, bounds);
+    g_recorder.Impacts(0, impacts);
 }
 
 // Per-window physics (use per-window bounds)
 static void UpdatePhysicsMW(MonitorWindow& mw, float dt) {
-    mw.spinAngle += mw.spinDir * g_spinSpeed * dt;
-    if (mw.spinAngle > 360.0f) mw.spinAngle -= 360.0f;
-    if (mw.spinAngle < 0.0f)   mw.spinAngle += 360.0f;
-
-    mw.vy += GRAVITY * dt;
-    mw.ballX += mw.vx * dt;
-    mw.ballY += mw.vy * dt;
-    mw.ballZ += mw.vz * dt;
-
-    if (mw.ballY < mw.floorY + BALL_RADIUS) {
-        mw.ballY = mw.floorY + BALL_RADIUS;
-        mw.vy = 4.5f;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGF), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
-        }
+    const WorldBounds bounds = { mw.wallX, mw.wallZ, mw.floorY };
+    SimImpacts impacts;
+    StepBall(mw.ball, bounds, CurrentSimParams(), dt, &impacts);
+    PlayImpactSound(impacts);
+    EmitImpactParticles(OutputIndex(mw), impacts, bounds);
+    g_recorder.Impacts(OutputIndex(mw), impacts);
+}
+
+// The sphere mesh under the current modelview: its display list, or the shared mesh straight
+// from client arrays when the context could not give it a list
+static void CallSphere(MonitorWindow& mw) {
+    if (mw.sphereList != 0) {
+        glCallList(mw.sphereList);
+        return;
+    }
+    const SphereMeshView& mesh = g_assets.sphere[(g_settings.geometryMode == 1) ? 1 : 0];
+    if (!mesh.indices) return;
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, mesh.positions);
+    glNormalPointer(GL_FLOAT, 0, mesh.normals);
+    glTexCoordPointer(2, GL_FLOAT, 0, mesh.texcoords);
+    glDrawElements(GL_TRIANGLES, (GLsizei)mesh.indexCount, GL_UNSIGNED_SHORT, mesh.indices);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+// Sphere draw (per-window resources; the mesh is always built at BALL_RADIUS)
+static void DrawSphere(MonitorWindow& mw) {
+    GLBindTexture2D(mw.glState, mw.checkerTex);
+    CallSphere(mw);
+}
+
+// Floor and back-wall grid lines in immediate mode; returns the line count
+static size_t EmitGridLines(float floorY) {
+    size_t lines = 0;
+    glBegin(GL_LINES);
+    ForEachGridLine(floorY, [&lines](float x0, float y0, float z0, float x1, float y1, float z1) {
+        glVertex3f(x0, y0, z0);
+        glVertex3f(x1, y1, z1);
+        ++lines;
+    });
+    glEnd();
+    return lines;
+}
+
+// Compile the grid for the window's floor height (per-context)
+static void EnsureGridList(MonitorWindow& mw) {
+    if (mw.gridList != 0 && mw.gridListFloorY == mw.floorY) return;
+    if (mw.gridList == 0) mw.gridList = glGenLists(1);
+    if (mw.gridList == 0) return;
+
+    glNewList(mw.gridList, GL_COMPILE);
+    const size_t lines = EmitGridLines(mw.floorY);
+    glEndList();
+    mw.gridListFloorY = mw.floorY;
+    NoteGpuUpload(mw, GPU_GRID, lines * 2 * 3 * sizeof(float));
+}
+
+// Per-frame ball instances (BoingScene.h): every ball on an output and its two shadows are drawn
+// from this batch with one matrix load and one sphere call per instance, grouped so each render
+// state is set once per pass
+BallBatch g_ballBatch;
+
+// Impostor atlas
+// The ball only changes with spin angle (tilt and light are fixed), and the 16-wide checker repeats
+// every 45 degrees, so a handful of captured frames covers every orientation. Each context captures
+// its own atlas once per resolution bucket and then draws the ball as one alpha-tested quad.
+const int   IMPOSTOR_FRAMES = 32;          // Spin angles captured across one pattern period
+const int   IMPOSTOR_COLS = 8;             // Atlas grid is 8 x 4 cells
+const int   IMPOSTOR_ROWS = 4;
+const float IMPOSTOR_PERIOD_DEG = 45.0f;   // Two checker columns (16 columns around the ball)
+const int   IMPOSTOR_MIN_CELL = 32;
+const int   IMPOSTOR_MAX_CELL = 256;
+
+// Pick the power-of-two cell size that covers the ball's on-screen diameter for this window
+static int ImpostorBucketForSize(int w, int h) {
+    if (w <= 0) w = 1;
+    if (h <= 0) h = 1;
+    float halfHeight = -SceneBoundsForSize(w, h).floorY;
+    int diameter = (int)ceilf((float)h * (2.0f * BALL_RADIUS) / (2.0f * halfHeight));
+
+    int cell = IMPOSTOR_MIN_CELL;
+    while (cell < diameter && cell < IMPOSTOR_MAX_CELL) cell *= 2;
+
+    // Cells are rendered in the back buffer before capture, so they must fit the window
+    int limit = (w < h) ? w : h;
+    while (cell > limit && cell > 1) cell /= 2;
+    return cell;
+}
+
+// Render every spin angle into the back buffer and copy each into its atlas cell
+static bool BuildImpostorAtlas(MonitorWindow& mw, int cell) {
+    GLint alphaBits = 0;
+    glGetIntegerv(GL_ALPHA_BITS, &alphaBits);
+    if (alphaBits == 0 || cell < 8) return false; // No cut-out possible; keep drawing the sphere
+
+    GLStateCache& gs = mw.glState;
+    if (mw.impostorTex == 0) glGenTextures(1, &mw.impostorTex);
+    GLBindTexture2D(gs, mw.impostorTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, cell * IMPOSTOR_COLS, cell * IMPOSTOR_ROWS, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Orthographic capture: the ball exactly fills one cell
+    glViewport(0, 0, cell, cell);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(-BALL_RADIUS, BALL_RADIUS, -BALL_RADIUS, BALL_RADIUS, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+
+    const uint32_t caps = GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_BLEND | GLCAP_TEXTURE_2D;
+    GLApplyCaps(gs, g_settings.ballLighting ? (caps | GLCAP_LIGHTING) : caps);
+    GLSetColor(gs, 1.0f, 1.0f, 1.0f, 1.0f);
+    GLSetClearColor(gs, 0.0f, 0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < IMPOSTOR_FRAMES; ++i) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        glLoadIdentity();
+        glRotatef(90.0f, 1, 0, 0);
+        glRotatef(-15.0f, 0, 1, 0);
+        glRotatef(IMPOSTOR_PERIOD_DEG * (float)i / (float)IMPOSTOR_FRAMES, 0, 0, 1);
+        DrawSphere(mw);
+
+        GLBindTexture2D(gs, mw.impostorTex);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0,
+            (i % IMPOSTOR_COLS) * cell, (i / IMPOSTOR_COLS) * cell, 0, 0, cell, cell);
     }
+    gs.modelviewKnown = false;   // Loaded around the cache
+    mw.projectionDirty = true;   // Capture replaced the viewport and projection
+
+    mw.impostorCell = cell;
+    mw.impostorGeometry = g_settings.geometryMode;
+    mw.impostorLit = g_settings.ballLighting;
+    NoteGpuUpload(mw, GPU_IMPOSTOR, (size_t)cell * IMPOSTOR_COLS * (size_t)cell * IMPOSTOR_ROWS * 4);
+    return true;
+}
+
+// Rebuild the atlas when the window moves into another resolution bucket or settings changed
+static bool EnsureImpostorAtlas(MonitorWindow& mw, int w, int h) {
+    int cell = ImpostorBucketForSize(w, h);
+    if (mw.impostorTex != 0 && mw.impostorCell == cell &&
+        mw.impostorGeometry == g_settings.geometryMode && mw.impostorLit == g_settings.ballLighting) {
+        return true;
+    }
+    return BuildImpostorAtlas(mw, cell);
+}
 
-    if (mw.ballX > mw.wallX - BALL_RADIUS) {
-        mw.ballX = mw.wallX - BALL_RADIUS;
-        mw.vx = -fabsf(mw.vx);
-        mw.spinDir *= -1;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGW), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
+// Render state for a run of impostor quads
+static void BeginImpostorDraw(MonitorWindow& mw) {
+    GLStateCache& gs = mw.glState;
+    GLApplyCaps(gs, GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_TEXTURE_2D | GLCAP_ALPHA_TEST);
+    GLSetColor(gs, 1.0f, 1.0f, 1.0f, 1.0f);
+    GLBindTexture2D(gs, mw.impostorTex);
+    glBegin(GL_QUADS);
+}
+
+static void EndImpostorDraw() {
+    glEnd();
+}
+
+// Emit one camera-facing quad at (x, y, z) (eye space offset baked in) textured with the nearest
+// captured spin angle; the quads of a whole batch share one glBegin/glEnd
+static void EmitImpostorQuad(float x, float y, float z, float spinAngle) {
+    float phase = fmodf(spinAngle, IMPOSTOR_PERIOD_DEG);
+    if (phase < 0.0f) phase += IMPOSTOR_PERIOD_DEG;
+    int frame = (int)(phase / IMPOSTOR_PERIOD_DEG * (float)IMPOSTOR_FRAMES + 0.5f) % IMPOSTOR_FRAMES;
+
+    float s0 = (float)(frame % IMPOSTOR_COLS) / (float)IMPOSTOR_COLS;
+    float t0 = (float)(frame / IMPOSTOR_COLS) / (float)IMPOSTOR_ROWS;
+    float s1 = s0 + 1.0f / (float)IMPOSTOR_COLS;
+    float t1 = t0 + 1.0f / (float)IMPOSTOR_ROWS;
+
+    glTexCoord2f(s0, t0); glVertex3f(x - BALL_RADIUS, y - BALL_RADIUS, z);
+    glTexCoord2f(s1, t0); glVertex3f(x + BALL_RADIUS, y - BALL_RADIUS, z);
+    glTexCoord2f(s1, t1); glVertex3f(x + BALL_RADIUS, y + BALL_RADIUS, z);
+    glTexCoord2f(s0, t1); glVertex3f(x - BALL_RADIUS, y + BALL_RADIUS, z);
+}
+
+// Draw every ball in the batch: all floor shadows, all wall shadows, then all balls
+// Shadows are untextured black (black modulated by the checker is black anyway), so they share the
+// grid's state and only the ball pass turns texturing and lighting on.
+static void DrawBallBatch(MonitorWindow& mw, const BallBatch& batch, bool useImpostor) {
+    const size_t n = batch.size();
+    if (n == 0) return;
+    GLStateCache& gs = mw.glState;
+    GLfloat m[16];
+
+    if (g_settings.floorShadow) {
+        GLApplyCaps(gs, GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_BLEND);
+        GLSetColor(gs, 0.0f, 0.0f, 0.0f, SCENE_FLOOR_SHADOW_ALPHA);
+        for (size_t i = 0; i < n; ++i) {
+            SceneFloorShadowMatrix(m, batch.x[i], batch.floorY[i], batch.z[i]);
+            GLLoadModelview(gs, m);
+            CallSphere(mw);
         }
     }
-    else if (mw.ballX < -mw.wallX + BALL_RADIUS) {
-        mw.ballX = -mw.wallX + BALL_RADIUS;
-        mw.vx = +fabsf(mw.vx);
-        mw.spinDir *= -1;
-        if (g_soundEnabled && !g_soundPlayedThisFrame) {
-            PlaySound(MAKEINTRESOURCE(BOINGW), g_hInst, SND_RESOURCE | SND_ASYNC);
-            g_soundPlayedThisFrame = true;
+
+    if (g_settings.wallShadow) {
+        GLApplyCaps(gs, GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_BLEND);
+        GLSetColor(gs, 0.0f, 0.0f, 0.0f, SCENE_WALL_SHADOW_ALPHA);
+        for (size_t i = 0; i < n; ++i) {
+            SceneWallShadowMatrix(m, batch.x[i], batch.y[i]);
+            GLLoadModelview(gs, m);
+            CallSphere(mw);
         }
     }
 
-    if (mw.ballZ > mw.wallZ - BALL_RADIUS) {
-        mw.ballZ = mw.wallZ - BALL_RADIUS;
-        mw.vz = -fabsf(mw.vz);
+    if (useImpostor) {
+        // Quads are emitted in eye space, so the whole batch is a single glBegin/glEnd
+        static const GLfloat identity[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+        GLLoadModelview(gs, identity);
+        BeginImpostorDraw(mw);
+        for (size_t i = 0; i < n; ++i) {
+            EmitImpostorQuad(batch.x[i], batch.y[i], batch.z[i] - SCENE_CAMERA_Z, batch.spin[i]);
+        }
+        EndImpostorDraw();
     }
-    else if (mw.ballZ < -mw.wallZ + BALL_RADIUS) {
-        mw.ballZ = -mw.wallZ + BALL_RADIUS;
-        mw.vz = +fabsf(mw.vz);
+    else {
+        const uint32_t caps = GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_BLEND | GLCAP_TEXTURE_2D;
+        GLApplyCaps(gs, g_settings.ballLighting ? (caps | GLCAP_LIGHTING) : caps);
+        if (!g_settings.ballLighting) GLSetColor(gs, 1.0f, 1.0f, 1.0f, 1.0f);
+        GLBindTexture2D(gs, mw.checkerTex);
+        for (size_t i = 0; i < n; ++i) {
+            SceneBallMatrix(m, batch.x[i], batch.y[i], batch.z[i], batch.spin[i]);
+            GLLoadModelview(gs, m);
+            CallSphere(mw);
+        }
     }
 }
 
-// Sphere draw (per-window resources)
-static void DrawSphere(const MonitorWindow& mw, float r) {
-    glBindTexture(GL_TEXTURE_2D, mw.checkerTex);
-    int slices = (g_geometryMode == 1) ? 16 : 64;
-    int stacks = (g_geometryMode == 1) ? 8 : 32;
-    gluSphere(mw.quadric, r, slices, stacks);
+// Make a monitor's context current, revive its resources and apply its viewport
+static bool BeginFrameMonitor(MonitorWindow& mw, bool& useImpostor) {
+    // Resources are not polled: they live as long as the context, and a lost context is
+    // noticed here (or by a failed present) and rebuilt as a whole
+    if (!mw.hGL || !wglMakeCurrent(mw.hDC, mw.hGL)) {
+        if (!RecoverOutputContext(mw)) return false;   // Skip this monitor this frame
+    }
+    if (mw.core.Ready()) return true;      // Viewport and meshes are the core renderer's own
+
+    // Normally uploaded during setup; the sphere is rebuilt here after a geometry mode change
+    EnsureCheckerTexture(mw);
+    EnsureSphereList(mw);
+
+    // Impostor atlas capture uses the back buffer, so it runs before this frame's clear
+    useImpostor = g_settings.impostor && EnsureImpostorAtlas(mw, mw.viewW, mw.viewH);
+
+    // Viewport/projection live in the context; reload only after a resize or a capture replaced them
+    if (mw.projectionDirty) ApplyOutputProjection(mw);
+    return true;
 }
 
-// Per-monitor render
-static void RenderFrameMonitor(MonitorWindow& mw, bool useGlobalState, float dt) {
-    if (!wglMakeCurrent(mw.hDC, mw.hGL)) {
-        return; // Skip this monitor this frame if context couldn't be made current
+// Draw the scene with the core renderer (no present): the same passes, fed from one per-frame buffer
+static void DrawSceneCore(MonitorWindow& mw, const BallBatch& batch, bool useGlobalState) {
+    CoreScene scene;
+    scene.width = mw.viewW;
+    scene.height = mw.viewH;
+    scene.clear[0] = GetRValue(g_settings.bgColor) / 255.0f;
+    scene.clear[1] = GetGValue(g_settings.bgColor) / 255.0f;
+    scene.clear[2] = GetBValue(g_settings.bgColor) / 255.0f;
+    scene.grid = g_settings.grid;
+    scene.floorShadow = g_settings.floorShadow;
+    scene.wallShadow = g_settings.wallShadow;
+    scene.lighting = g_settings.ballLighting;
+    scene.geometry = g_settings.geometryMode;
+    scene.floorY = mw.floorY;
+    scene.ballX = batch.x;
+    scene.ballY = batch.y;
+    scene.ballZ = batch.z;
+    scene.ballSpin = batch.spin;
+    scene.ballFloorY = batch.floorY;
+    scene.ballCount = batch.size();
+    if (g_settings.impactParticles) {
+        const size_t world = useGlobalState ? 0 : OutputIndex(mw);
+        scene.particles = g_particles.VerticesOf(world);
+        scene.particleCount = g_particles.LiveIn(world);
+        scene.particleOffsetX = useGlobalState ? mw.worldOffsetX : 0.0f;
     }
+    mw.core.Draw(scene);
+}
 
-    // Ensure per-context resources are alive and bound
-    if (mw.checkerTex == 0 || !glIsTexture(mw.checkerTex)) {
-        // Recreate texture in this context if it was lost
-        mw.checkerTex = MakeCheckerTexture();
+// Draw the scene into the back buffer (no present)
+// Passes run in state order: untextured and unlit (grid, shadows), then the textured ball, then
+// the particles, which must come last because they do not write depth
+static void DrawSceneMonitor(MonitorWindow& mw, bool useGlobalState, bool useImpostor) {
+    // Gather this output's balls, then draw balls and shadows in grouped passes
+    g_ballBatch.begin(g_frameArena, BALL_BATCH_CAPACITY);
+    if (useGlobalState) g_ballBatch.add(g_ball.x - mw.worldOffsetX, g_ball.y, g_ball.z, g_ball.spin, g_FLOOR_Y);
+    else                g_ballBatch.add(mw.ball.x, mw.ball.y, mw.ball.z, mw.ball.spin, mw.floorY);
+    if (mw.core.Ready()) {
+        DrawSceneCore(mw, g_ballBatch, useGlobalState);
+        return;
     }
-    glBindTexture(GL_TEXTURE_2D, mw.checkerTex);
 
-    if (mw.quadric == nullptr) {
-        mw.quadric = gluNewQuadric();
-        gluQuadricTexture(mw.quadric, GL_TRUE);
-        gluQuadricNormals(mw.quadric, GLU_SMOOTH);
+    GLStateCache& gs = mw.glState;
+    GLSetClearColor(gs,
+        GetRValue(g_settings.bgColor) / 255.0f,
+        GetGValue(g_settings.bgColor) / 255.0f,
+        GetBValue(g_settings.bgColor) / 255.0f,
+        1.0f
+    );
+    GLApplyCaps(gs, GLCAP_DEPTH_TEST | GLCAP_DEPTH_WRITE | GLCAP_BLEND);   // The depth clear obeys the mask
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (g_settings.grid) {
+        GLLoadCamera(gs, 0.0f);
+        GLSetColor(gs, SCENE_GRID_COLOR[0], SCENE_GRID_COLOR[1], SCENE_GRID_COLOR[2], 1.0f);
+        GLSetLineWidth(gs, SCENE_GRID_LINE_WIDTH);
+        EnsureGridList(mw);
+        if (mw.gridList != 0) glCallList(mw.gridList);
+        else                  EmitGridLines(mw.floorY);     // No list to be had: draw it directly
     }
 
-    // Re-apply viewport/projection to ensure bounds match current size
-    RECT rc; GetClientRect(mw.hWnd, &rc);
-    int w = rc.right - rc.left;
-    int h = rc.bottom - rc.top;
-    ApplyViewportAndProjection(mw, w, h);
+    DrawBallBatch(mw, g_ballBatch, useImpostor);
+    if (g_settings.impactParticles) {
+        DrawParticles(mw, useGlobalState ? 0 : OutputIndex(mw), useGlobalState ? mw.worldOffsetX : 0.0f);
+    }
+}
+
+// Capture the inputs that determine this output's image
+// The wall shadow sits one unit behind the ball plane, where the view is 1.5x wider, so the ball
+// affects an output while it is within 1.5x of its half-width (plus radius) from the centre.
+static FrameSignature ComputeFrameSignature(const MonitorWindow& mw, bool useGlobalState, int w, int h) {
+    FrameSignature sig;
+    float x = useGlobalState ? (g_ball.x - mw.worldOffsetX) : mw.ball.x;
+    sig.ballInView = fabsf(x) < 1.5f * (mw.wallX + BALL_RADIUS);
+    if (sig.ballInView) {
+        sig.ballX = x;
+        sig.ballY = useGlobalState ? g_ball.y : mw.ball.y;
+        sig.ballZ = useGlobalState ? g_ball.z : mw.ball.z;
+        sig.spin = useGlobalState ? g_ball.spin : mw.ball.spin;
+    }
+    sig.floorY = useGlobalState ? g_FLOOR_Y : mw.floorY;
+    sig.wallX = mw.wallX;
+    sig.width = w;
+    sig.height = h;
+    sig.settings =
+        (g_settings.floorShadow ? 1u : 0u) | (g_settings.wallShadow ? 2u : 0u) |
+        (g_settings.grid ? 4u : 0u) | (g_settings.ballLighting ? 8u : 0u) |
+        (g_settings.impostor ? 16u : 0u) | ((uint32_t)(g_settings.geometryMode & 0xFF) << 8);
+    sig.bgColor = g_settings.bgColor;
+    if (g_settings.impactParticles && g_particles.LiveIn(useGlobalState ? 0 : OutputIndex(mw))) {
+        sig.particles = g_particles.Updates();
+    }
+    return sig;
+}
 
+// Per-monitor render
+static void RenderFrameMonitor(MonitorWindow& mw, bool useGlobalState, float dt) {
     if (!useGlobalState) {
         UpdatePhysicsMW(mw, dt * g_timeScale);
     }
 
-    glClearColor(
-        GetRValue(g_bgColor) / 255.0f,
-        GetGValue(g_bgColor) / 255.0f,
-        GetBValue(g_bgColor) / 255.0f,
-        1.0f
-    );
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // Nothing that feeds the image changed: keep the presented frame, skip draw and SwapBuffers
+    FrameSignature sig = ComputeFrameSignature(mw, useGlobalState, mw.viewW, mw.viewH);
+    if (mw.framePresented && sig == mw.lastFrame) {
+        g_telemetry.framesSkipped++;
+        return;
+    }
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    glTranslatef(0, 0, -2.0f);
-
-    glDisable(GL_LIGHTING);
-    glColor3f(0.3f, 0.6f, 1.0f);
-    glLineWidth(2.0f);
-
-    if (g_gridEnabled) {
-        glBegin(GL_LINES);
-        for (float i = -1.0f; i <= 1.0f; i += 0.2f) {
-            glVertex3f(i, mw.floorY, -1.0f);
-            glVertex3f(i, mw.floorY, 1.0f);
-            glVertex3f(-1.0f, mw.floorY, i);
-            glVertex3f(1.0f, mw.floorY, i);
-        }
-        glEnd();
+    bool useImpostor = false;
+    if (!BeginFrameMonitor(mw, useImpostor)) return;
+
+    DrawSceneMonitor(mw, useGlobalState, useImpostor);
+    ExportFrame(mw);
+    if (!SwapBuffers(mw.hDC)) {
+        NoteContextLost(mw);
+        return;
+    }
 
-        glBegin(GL_LINES);
-        for (float x = -1.0f; x <= 1.0f; x += 0.2f) {
-            glVertex3f(x, mw.floorY, -1.0f);
-            glVertex3f(x, mw.floorY + 2.0f, -1.0f);
+    mw.lastFrame = sig;
+    mw.framePresented = true;
+    g_telemetry.framesRendered++;
+}
+
+// Spanned world
+// One continuous world laid out as a left-to-right strip: monitors are ordered by their left edge
+// and placed side by side in world units (each is 2 * wallX wide at the ball plane), and the global
+// ball travels across them. Every slice shows the full world height over one common floor, so
+// vertical offsets and horizontal gaps between monitors are not reproduced, and a shorter monitor
+// shows its slice at a smaller scale. Each window renders through a camera centred on its slice.
+// Monitors that overlap horizontally (stacked or staggered) cannot form a strip: that layout is
+// rejected and every monitor shows the whole world, as in Replicated.
+static void LayoutSpannedWorld() {
+    if (g_monitorWindows.empty()) return;
+
+    size_t order[MAX_OUTPUTS];
+    const size_t count = g_monitorWindows.size();
+    for (size_t i = 0; i < count; ++i) order[i] = i;
+    for (size_t i = 1; i < count; ++i) {
+        // Insertion sort by left edge (then top), a handful of monitors at most
+        size_t k = order[i], j = i;
+        while (j > 0) {
+            const RECT& a = g_monitorWindows[order[j - 1]].monitorRect;
+            const RECT& b = g_monitorWindows[k].monitorRect;
+            if (a.left < b.left || (a.left == b.left && a.top <= b.top)) break;
+            order[j] = order[j - 1];
+            --j;
         }
-        for (float y = mw.floorY; y <= mw.floorY + 2.0f; y += 0.2f) {
-            glVertex3f(-1.0f, y, -1.0f);
-            glVertex3f(1.0f, y, -1.0f);
+        order[j] = k;
+    }
+
+    bool strip = true;
+    for (size_t n = 1; n < count; ++n) {
+        if (g_monitorWindows[order[n - 1]].monitorRect.right > g_monitorWindows[order[n]].monitorRect.left) strip = false;
+    }
+
+    // One floor for the whole world. The vertical field of view is fixed, so every slice's floor
+    // is already at the same height; the grid and the ball are both drawn at this one
+    float floorY = g_monitorWindows[0].floorY;
+    for (auto& mw : g_monitorWindows) floorY = (std::max)(floorY, mw.floorY);
+    for (auto& mw : g_monitorWindows) {
+        mw.floorY = floorY;
+        mw.framePresented = false;
+    }
+    g_FLOOR_Y = floorY;
+
+    if (!strip) {
+        OutputDebugStringA("BoingBallSaver: spanned world needs monitors side by side; showing the whole world on each\n");
+        float wallX = g_monitorWindows[0].wallX, wallZ = g_monitorWindows[0].wallZ;
+        for (auto& mw : g_monitorWindows) {
+            mw.worldOffsetX = 0.0f;
+            wallX = (std::min)(wallX, mw.wallX);     // The ball stays in view on the narrowest monitor
+            wallZ = (std::min)(wallZ, mw.wallZ);
         }
-        glEnd();
+        g_WALL_X = wallX;
+        g_WALL_Z = wallZ;
+        return;
     }
 
-    if (g_floorShadowEnabled) {
-        glDisable(GL_LIGHTING);
-        glColor4f(0.0f, 0.0f, 0.0f, 0.4f);
-        glPushMatrix();
-        if (useGlobalState) glTranslatef(g_ballX, g_FLOOR_Y + 0.001f, g_ballZ);
-        else                glTranslatef(mw.ballX, mw.floorY + 0.001f, mw.ballZ);
-        glScalef(1.0f, 0.1f, 1.0f);
-        DrawSphere(mw, BALL_RADIUS);
-        glPopMatrix();
+    float cursor = 0.0f;
+    for (size_t n = 0; n < count; ++n) {
+        MonitorWindow& mw = g_monitorWindows[order[n]];
+        mw.worldOffsetX = cursor + mw.wallX;
+        cursor += 2.0f * mw.wallX;
     }
 
-    if (g_wallShadowEnabled) {
-        glDisable(GL_LIGHTING);
-        glColor4f(0.0f, 0.0f, 0.0f, 0.3f);
-        glPushMatrix();
-        if (useGlobalState) glTranslatef(g_ballX, g_ballY, -1.0f);
-        else                glTranslatef(mw.ballX, mw.ballY, -1.0f);
-        glScalef(1.0f, 1.0f, 0.1f);
-        DrawSphere(mw, BALL_RADIUS);
-        glPopMatrix();
+    // Centre the world on x = 0 so the global wall bounds stay symmetric
+    float half = cursor * 0.5f;
+    for (auto& mw : g_monitorWindows) mw.worldOffsetX -= half;
+
+    g_WALL_X = half;
+    g_WALL_Z = g_monitorWindows[0].wallZ;
+}
+
+// Refresh the global world bounds after any output's cached bounds changed
+// Single and Replicated take them from the first window, Spanned re-lays out every slice.
+static void SyncWorldBounds() {
+    if (g_monitorWindows.empty()) return;
+    g_recordLayoutDirty = true;
+    if (g_settings.multiMonitorMode == 4) {
+        LayoutSpannedWorld();
     }
+    else if (g_settings.multiMonitorMode == 2 || g_settings.multiMonitorMode == 0) {
+        const MonitorWindow& first = g_monitorWindows[0];
+        g_WALL_X = first.wallX;
+        g_WALL_Z = first.wallZ;
+        g_FLOOR_Y = first.floorY;
+    }
+}
 
-    glEnable(GL_LIGHTING);
+// Preview frame cache
+// In preview the ball bounces at a fixed floor velocity and a constant horizontal speed, so its
+// motion is periodic. We nudge the horizontal speed so one wall round trip spans a whole number of
+// floor bounces, render that single cycle once into memory, and then just replay it.
+const float PREVIEW_CACHE_FPS = 30.0f;
+const size_t PREVIEW_CACHE_BUDGET = 16u * 1024u * 1024u;  // Bytes of RGB frames we are willing to hold
+const float PREVIEW_BOUNCE_VY = 4.5f;                      // Matches the floor reset in the physics
+
+enum PreviewSound : unsigned char {
+    PREVIEW_SOUND_NONE = 0,
+    PREVIEW_SOUND_FLOOR = 1,
+    PREVIEW_SOUND_WALL = 2
+};
 
-    glPushMatrix();
-    if (useGlobalState) {
-        glTranslatef(g_ballX, g_ballY, g_ballZ);
-        glRotatef(90.0f, 1, 0, 0);
-        glRotatef(-15.0f, 0, 1, 0);
-        glRotatef(g_spinAngle, 0, 0, 1);
+struct PreviewFrameCache {
+    bool  attempted = false;   // Build tried (success or not) for the current size
+    bool  ready = false;
+    int   width = 0, height = 0;
+    int   frameCount = 0;
+    float fps = PREVIEW_CACHE_FPS;
+    float simPeriod = 0.0f;    // Cycle length in simulation seconds
+    float vx = 0.0f;           // Horizontal speed adjusted to make the cycle close
+    int   lastFrame = -1;
+    LARGE_INTEGER start = {};
+    std::vector<unsigned char> pixels;   // frameCount * width * height * 3 (bottom-up RGB)
+    std::vector<unsigned char> sounds;   // PreviewSound bits raised while reaching each frame
+};
+
+PreviewFrameCache g_previewCache;
+
+// Closed-form ball state at simulation time t (starting on the floor at the left wall)
+static void PreviewStateAt(const MonitorWindow& mw, float t, float vx) {
+    const float bouncePeriod = 2.0f * PREVIEW_BOUNCE_VY / -GRAVITY;
+    const float lane = 2.0f * (mw.wallX - BALL_RADIUS);
+
+    float u = fmodf(t, bouncePeriod);
+    g_ball.y = mw.floorY + BALL_RADIUS + PREVIEW_BOUNCE_VY * u + 0.5f * GRAVITY * u * u;
+
+    float p = fmodf(vx * t, 2.0f * lane);
+    bool rightward = p < lane;
+    g_ball.x = rightward ? (-mw.wallX + BALL_RADIUS + p) : (mw.wallX - BALL_RADIUS - (p - lane));
+    g_ball.z = 0.0f;
+    g_ball.vx = rightward ? vx : -vx;
+    g_ball.spinDir = rightward ? 1 : -1;
+
+    // Spin integrates the direction, so it winds up going right and back down coming left
+    float travelled = rightward ? p : (2.0f * lane - p);
+    g_ball.spin = fmodf(g_spinSpeed * travelled / vx, 360.0f);
+}
+
+// Render one full cycle into the cache (context current, viewport applied)
+static bool BuildPreviewCache(MonitorWindow& mw, int w, int h, bool useImpostor) {
+    PreviewFrameCache& pc = g_previewCache;
+    NoteExpectedAllocations();   // The frame store is allocated once per cycle build
+    pc.attempted = true;
+    pc.ready = false;
+    pc.width = w;
+    pc.height = h;
+    if (w <= 0 || h <= 0) return false;
+
+    const float bouncePeriod = 2.0f * PREVIEW_BOUNCE_VY / -GRAVITY;
+    const float lane = 2.0f * (mw.wallX - BALL_RADIUS);
+    if (lane <= 0.0f) return false;
+
+    // Whole number of floor bounces per wall round trip
+    int bounces = (int)floorf((2.0f * lane / fabsf(g_ball.vx)) / bouncePeriod + 0.5f);
+    if (bounces < 1) bounces = 1;
+    pc.simPeriod = bounces * bouncePeriod;
+    pc.vx = 2.0f * lane / pc.simPeriod;
+
+    // Fit the cycle into the memory budget, dropping the frame rate if we must
+    const size_t frameBytes = (size_t)w * (size_t)h * 3u;
+    const float realPeriod = pc.simPeriod / g_timeScale;
+    pc.fps = PREVIEW_CACHE_FPS;
+    pc.frameCount = (int)ceilf(realPeriod * pc.fps);
+    while ((size_t)pc.frameCount * frameBytes > PREVIEW_CACHE_BUDGET && pc.fps > 10.0f) {
+        pc.fps *= 0.5f;
+        pc.frameCount = (int)ceilf(realPeriod * pc.fps);
     }
-    else {
-        glTranslatef(mw.ballX, mw.ballY, mw.ballZ);
-        glRotatef(90.0f, 1, 0, 0);
-        glRotatef(-15.0f, 0, 1, 0);
-        glRotatef(mw.spinAngle, 0, 0, 1);
+    if ((size_t)pc.frameCount * frameBytes > PREVIEW_CACHE_BUDGET) return false;
+    pc.fps = (float)pc.frameCount / realPeriod;  // Land exactly on the cycle length
+
+    pc.pixels.assign((size_t)pc.frameCount * frameBytes, 0);
+    pc.sounds.assign(pc.frameCount, PREVIEW_SOUND_NONE);
+
+    g_WALL_X = mw.wallX;
+    g_WALL_Z = mw.wallZ;
+    g_FLOOR_Y = mw.floorY;
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadBuffer(GL_BACK);
+    const float step = pc.simPeriod / (float)pc.frameCount;
+    for (int i = 0; i < pc.frameCount; ++i) {
+        float t = step * (float)i;
+        float tPrev = t - step;
+
+        // Bounces and wall hits crossed since the previous frame (frame 0 is the floor/left-wall corner)
+        int floorNow = (int)floorf(t / bouncePeriod), floorPrev = (int)floorf(tPrev / bouncePeriod);
+        int wallNow = (int)floorf(pc.vx * t / lane), wallPrev = (int)floorf(pc.vx * tPrev / lane);
+        if (floorNow != floorPrev) pc.sounds[i] |= PREVIEW_SOUND_FLOOR;
+        if (wallNow != wallPrev)   pc.sounds[i] |= PREVIEW_SOUND_WALL;
+
+        PreviewStateAt(mw, t, pc.vx);
+        DrawSceneMonitor(mw, true, useImpostor);
+        glReadPixels(0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, &pc.pixels[(size_t)i * frameBytes]);
+    }
+
+    pc.lastFrame = -1;
+    QueryPerformanceCounter(&pc.start);
+    pc.ready = true;
+    return true;
+}
+
+// Present the cached frame for the current time; returns false when the live path must render
+static bool PresentPreviewFrame(MonitorWindow& mw) {
+    PreviewFrameCache& pc = g_previewCache;
+
+    int w = mw.viewW;
+    int h = mw.viewH;
+    if (w != pc.width || h != pc.height) {
+        // Preview host resized us; the old cycle no longer fits
+        pc.attempted = false;
+        pc.ready = false;
+        pc.pixels.clear();
+        pc.sounds.clear();
     }
-    if (!g_ballLightingEnabled) {
-        glDisable(GL_LIGHTING);
-        glColor3f(1.0f, 1.0f, 1.0f);
+
+    if (!pc.attempted) {
+        bool useImpostor = false;
+        if (!BeginFrameMonitor(mw, useImpostor)) return false;
+        if (!BuildPreviewCache(mw, w, h, useImpostor)) {
+            pc.pixels.clear();
+            pc.sounds.clear();
+            return false;
+        }
     }
-    DrawSphere(mw, BALL_RADIUS);
-    if (!g_ballLightingEnabled) glEnable(GL_LIGHTING);
-    glPopMatrix();
+    if (!pc.ready) return false;
 
-    SwapBuffers(mw.hDC);
+    LARGE_INTEGER now; QueryPerformanceCounter(&now);
+    double elapsed = (double)(now.QuadPart - pc.start.QuadPart) / (double)g_freq.QuadPart;
+    int frame = (int)(elapsed * pc.fps) % pc.frameCount;
+    if (frame == pc.lastFrame) return true;  // Nothing new to show yet
+
+    // Sounds for every frame we stepped over since the last present
+    unsigned char sound = PREVIEW_SOUND_NONE;
+    if (pc.lastFrame >= 0) {
+        for (int i = (pc.lastFrame + 1) % pc.frameCount; ; i = (i + 1) % pc.frameCount) {
+            sound |= pc.sounds[i];
+            if (i == frame) break;
+        }
+    }
+    if (g_settings.sound) {
+        if (sound & PREVIEW_SOUND_FLOOR)     PlayBoingSound(SOUND_FLOOR);
+        else if (sound & PREVIEW_SOUND_WALL) PlayBoingSound(SOUND_WALL);
+    }
+    pc.lastFrame = frame;
+
+    if ((!mw.hGL || !wglMakeCurrent(mw.hDC, mw.hGL)) && !RecoverOutputContext(mw)) return true;
+
+    // Straight pixel copy: no texturing, lighting, depth or blending on the way to the back buffer
+    static const GLfloat identity[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+    GLApplyCaps(mw.glState, GLCAP_DEPTH_WRITE);
+    glViewport(0, 0, w, h);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    GLLoadModelview(mw.glState, identity);
+    glRasterPos2f(-1.0f, -1.0f);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glDrawPixels(w, h, GL_RGB, GL_UNSIGNED_BYTE, &pc.pixels[(size_t)frame * (size_t)w * (size_t)h * 3u]);
+    if (!SwapBuffers(mw.hDC)) NoteContextLost(mw);
+
+    // The scene passes set their own state if the cache has to be rebuilt or dropped later
+    mw.projectionDirty = true;
+    return true;
+}
+
+// Milliseconds until the cached preview needs its next frame
+static DWORD PreviewFrameWaitMs() {
+    const PreviewFrameCache& pc = g_previewCache;
+    if (!pc.ready || pc.fps <= 0.0f) return 1;
+
+    LARGE_INTEGER now; QueryPerformanceCounter(&now);
+    double elapsed = (double)(now.QuadPart - pc.start.QuadPart) / (double)g_freq.QuadPart;
+    double next = (floor(elapsed * pc.fps) + 1.0) / pc.fps;
+    double ms = (next - elapsed) * 1000.0;
+    return (ms < 1.0) ? 1 : (DWORD)ms;
 }
 
 // Config dialog
-// Config dialog
+// Edits a private copy of the settings; the running snapshot is never mutated.
+static SaverSettings s_dialogSettings;
+
 static INT_PTR CALLBACK ConfigDlgProc(HWND hDlg, UINT msg, WPARAM wParam, LPARAM) {
     switch (msg) {
     case WM_INITDIALOG: {
-        g_floorShadowEnabled = ReadBoolSetting(L"FloorShadow", DEFAULT_FLOOR_SHADOW);
-        g_wallShadowEnabled = ReadBoolSetting(L"WallShadow", DEFAULT_WALL_SHADOW);
-        g_gridEnabled = ReadBoolSetting(L"Grid", DEFAULT_GRID);
-        g_soundEnabled = ReadBoolSetting(L"Sound", DEFAULT_SOUND);
-        g_bgColor = ReadColorSetting(L"BackgroundColor", DEFAULT_BG_COLOR);
-        g_geometryMode = ReadIntSetting(L"GeometryMode", DEFAULT_GEOMETRY_MODE);
-        g_ballLightingEnabled = ReadBoolSetting(L"BallLighting", DEFAULT_BALL_LIGHTING);
-        g_multiMonitorMode = ReadIntSetting(L"MultiMonitorMode", DEFAULT_MULTI_MONITOR_MODE);
+        s_dialogSettings = LoadSettingsFromRegistry();
 
         /*Debugger*************************************************************************************************************************************
         DebugMode(L"Config WM_INITDIALOG after reads");
         */
-        CheckDlgButton(hDlg, IDC_FLOORSHADOW, g_floorShadowEnabled ? BST_CHECKED : BST_UNCHECKED);
-        CheckDlgButton(hDlg, IDC_WALLSHADOW, g_wallShadowEnabled ? BST_CHECKED : BST_UNCHECKED);
-        CheckDlgButton(hDlg, IDC_GRID, g_gridEnabled ? BST_CHECKED : BST_UNCHECKED);
-        CheckDlgButton(hDlg, IDC_SOUND, g_soundEnabled ? BST_CHECKED : BST_UNCHECKED);
-        CheckDlgButton(hDlg, IDC_GEOMETRY, g_geometryMode ? BST_CHECKED : BST_UNCHECKED);
-        CheckDlgButton(hDlg, IDC_BALLLIGHTING, g_ballLightingEnabled ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_FLOORSHADOW, s_dialogSettings.floorShadow ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_WALLSHADOW, s_dialogSettings.wallShadow ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_GRID, s_dialogSettings.grid ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_SOUND, s_dialogSettings.sound ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_GEOMETRY, s_dialogSettings.geometryMode ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_BALLLIGHTING, s_dialogSettings.ballLighting ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_IMPOSTOR, s_dialogSettings.impostor ? BST_CHECKED : BST_UNCHECKED);
+        CheckDlgButton(hDlg, IDC_PARTICLES, s_dialogSettings.impactParticles ? BST_CHECKED : BST_UNCHECKED);
 
         // Explicit radio set (do not rely on CheckRadioButton grouping)
-        SetMonitorModeRadios(hDlg, g_multiMonitorMode);
+        SetMonitorModeRadios(hDlg, s_dialogSettings.multiMonitorMode);
         return TRUE;
     }
 
@@ -671,67 +2176,59 @@ static INT_PTR CALLBACK ConfigDlgProc(HWND hDlg, UINT msg, WPARAM wParam, LPARAM
             CHOOSECOLOR cc = { sizeof(CHOOSECOLOR) };
             cc.hwndOwner = hDlg;
             cc.lpCustColors = customColors;
-            cc.rgbResult = g_bgColor;
+            cc.rgbResult = s_dialogSettings.bgColor;
             cc.Flags = CC_RGBINIT | CC_FULLOPEN;
             if (ChooseColor(&cc)) {
-                g_bgColor = cc.rgbResult;
+                s_dialogSettings.bgColor = cc.rgbResult;
                 if (g_hWnd) InvalidateRect(g_hWnd, nullptr, FALSE);
             }
             return TRUE;
         }
 
         case IDC_RESTORE: {
-            g_floorShadowEnabled = DEFAULT_FLOOR_SHADOW;
-            g_wallShadowEnabled = DEFAULT_WALL_SHADOW;
-            g_gridEnabled = DEFAULT_GRID;
-            g_soundEnabled = DEFAULT_SOUND;
-            g_bgColor = DEFAULT_BG_COLOR;
-            g_geometryMode = DEFAULT_GEOMETRY_MODE;
-            g_ballLightingEnabled = DEFAULT_BALL_LIGHTING;
-            g_multiMonitorMode = DEFAULT_MULTI_MONITOR_MODE;
+            s_dialogSettings = DialogDefaults(s_dialogSettings);
 
 			/*Debugger****************************************************************************************************************************
-            g_multiMonitorMode = DEFAULT_MULTI_MONITOR_MODE;
+            s_dialogSettings.multiMonitorMode = DefaultSettings().multiMonitorMode;
             DebugMode(L"Config RESTORE after reset");
             */
             // Explicit radio set
-            SetMonitorModeRadios(hDlg, g_multiMonitorMode);
-
-            CheckDlgButton(hDlg, IDC_FLOORSHADOW, g_floorShadowEnabled ? BST_CHECKED : BST_UNCHECKED);
-            CheckDlgButton(hDlg, IDC_WALLSHADOW, g_wallShadowEnabled ? BST_CHECKED : BST_UNCHECKED);
-            CheckDlgButton(hDlg, IDC_GRID, g_gridEnabled ? BST_CHECKED : BST_UNCHECKED);
-            CheckDlgButton(hDlg, IDC_SOUND, g_soundEnabled ? BST_CHECKED : BST_UNCHECKED);
-            CheckDlgButton(hDlg, IDC_GEOMETRY, g_geometryMode ? BST_CHECKED : BST_UNCHECKED);
-            CheckDlgButton(hDlg, IDC_BALLLIGHTING, g_ballLightingEnabled ? BST_CHECKED : BST_UNCHECKED);
+            SetMonitorModeRadios(hDlg, s_dialogSettings.multiMonitorMode);
+
+            CheckDlgButton(hDlg, IDC_FLOORSHADOW, s_dialogSettings.floorShadow ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_WALLSHADOW, s_dialogSettings.wallShadow ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_GRID, s_dialogSettings.grid ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_SOUND, s_dialogSettings.sound ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_GEOMETRY, s_dialogSettings.geometryMode ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_BALLLIGHTING, s_dialogSettings.ballLighting ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_IMPOSTOR, s_dialogSettings.impostor ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hDlg, IDC_PARTICLES, s_dialogSettings.impactParticles ? BST_CHECKED : BST_UNCHECKED);
             return TRUE;
         }
 
         case IDOK: {
-            g_floorShadowEnabled = (IsDlgButtonChecked(hDlg, IDC_FLOORSHADOW) == BST_CHECKED);
-            g_wallShadowEnabled = (IsDlgButtonChecked(hDlg, IDC_WALLSHADOW) == BST_CHECKED);
-            g_gridEnabled = (IsDlgButtonChecked(hDlg, IDC_GRID) == BST_CHECKED);
-            g_soundEnabled = (IsDlgButtonChecked(hDlg, IDC_SOUND) == BST_CHECKED);
-            g_geometryMode = (IsDlgButtonChecked(hDlg, IDC_GEOMETRY) == BST_CHECKED) ? 1 : 0;
-            g_ballLightingEnabled = (IsDlgButtonChecked(hDlg, IDC_BALLLIGHTING) == BST_CHECKED);
+            s_dialogSettings.floorShadow = (IsDlgButtonChecked(hDlg, IDC_FLOORSHADOW) == BST_CHECKED);
+            s_dialogSettings.wallShadow = (IsDlgButtonChecked(hDlg, IDC_WALLSHADOW) == BST_CHECKED);
+            s_dialogSettings.grid = (IsDlgButtonChecked(hDlg, IDC_GRID) == BST_CHECKED);
+            s_dialogSettings.sound = (IsDlgButtonChecked(hDlg, IDC_SOUND) == BST_CHECKED);
+            s_dialogSettings.geometryMode = (IsDlgButtonChecked(hDlg, IDC_GEOMETRY) == BST_CHECKED) ? 1 : 0;
+            s_dialogSettings.ballLighting = (IsDlgButtonChecked(hDlg, IDC_BALLLIGHTING) == BST_CHECKED);
+            s_dialogSettings.impostor = (IsDlgButtonChecked(hDlg, IDC_IMPOSTOR) == BST_CHECKED);
+            s_dialogSettings.impactParticles = (IsDlgButtonChecked(hDlg, IDC_PARTICLES) == BST_CHECKED);
 
             // Read explicit radio checks
-            if (IsDlgButtonChecked(hDlg, IDC_MONITOR_SINGLE) == BST_CHECKED) g_multiMonitorMode = 0;
-            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_EXTENDED) == BST_CHECKED) g_multiMonitorMode = 1;
-            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_REPLICATED) == BST_CHECKED) g_multiMonitorMode = 2;
-            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_UNIFIED) == BST_CHECKED) g_multiMonitorMode = 3;
-            else g_multiMonitorMode = DEFAULT_MULTI_MONITOR_MODE;
+            if (IsDlgButtonChecked(hDlg, IDC_MONITOR_SINGLE) == BST_CHECKED) s_dialogSettings.multiMonitorMode = 0;
+            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_EXTENDED) == BST_CHECKED) s_dialogSettings.multiMonitorMode = 1;
+            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_REPLICATED) == BST_CHECKED) s_dialogSettings.multiMonitorMode = 2;
+            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_UNIFIED) == BST_CHECKED) s_dialogSettings.multiMonitorMode = 3;
+            else if (IsDlgButtonChecked(hDlg, IDC_MONITOR_SPANNED) == BST_CHECKED) s_dialogSettings.multiMonitorMode = 4;
+            else s_dialogSettings.multiMonitorMode = DefaultSettings().multiMonitorMode;
 			
             /*Debugger****************************************************************************************************************************
             DebugMode(L"Config IDOK before write");
             */
-            WriteBoolSetting(L"FloorShadow", g_floorShadowEnabled);
-            WriteBoolSetting(L"WallShadow", g_wallShadowEnabled);
-            WriteBoolSetting(L"Grid", g_gridEnabled);
-            WriteBoolSetting(L"Sound", g_soundEnabled);
-            WriteColorSetting(L"BackgroundColor", g_bgColor);
-            WriteIntSetting(L"GeometryMode", g_geometryMode);
-            WriteBoolSetting(L"BallLighting", g_ballLightingEnabled);
-            WriteIntSetting(L"MultiMonitorMode", g_multiMonitorMode);
+            RegistrySettingsBackend backend;
+            SaveSettings(backend, s_dialogSettings);
 
             EndDialog(hDlg, IDOK);
             return TRUE;
@@ -747,13 +2244,31 @@ static INT_PTR CALLBACK ConfigDlgProc(HWND hDlg, UINT msg, WPARAM wParam, LPARAM
     return FALSE;
 }
 
+#ifndef WM_DPICHANGED
+#define WM_DPICHANGED 0x02E0
+#endif
+
+static MonitorWindow* FindOutput(HWND hWnd) {
+    for (auto& mw : g_monitorWindows) {
+        if (mw.hWnd == hWnd) return &mw;
+    }
+    return nullptr;
+}
+
+// Recompute one output's cached view for a new client size
+static void OnOutputResized(HWND hWnd, int w, int h) {
+    MonitorWindow* mw = FindOutput(hWnd);
+    if (!mw || w <= 0 || h <= 0) return;   // Not set up yet, or minimized
+    if (mw->viewW == w && mw->viewH == h) return;
+    ComputeOutputBounds(*mw, w, h);
+    SyncWorldBounds();
+}
+
 // WndProc — no GL context creation, no rendering in WM_PAINT
 static LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
     case WM_CREATE: {
-        // Re‑read settings if you want to be extra safe
-        LoadSettingsFromRegistry();
-
+        // Settings are an immutable snapshot loaded once in wWinMain; nothing to re-read per window
         g_hWnd = hWnd;
         g_hDC = GetDC(hWnd);
         SetWindowPixelFormat(g_hDC);
@@ -764,7 +2279,9 @@ static LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPara
 
 
     case WM_PAINT: {
-        // No rendering here; single source of truth is the main loop.
+        // No rendering here; single source of truth is the main loop. An unchanged frame is
+        // normally skipped, so mark the output for a redraw of what was just exposed.
+        if (MonitorWindow* mw = FindOutput(hWnd)) mw->framePresented = false;
         ValidateRect(hWnd, NULL);
         return 0;
     }
@@ -778,8 +2295,27 @@ static LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPara
         if (!g_preview) QuitSaver();
         return 0;
 
+    case WM_SIZE:
+        OnOutputResized(hWnd, LOWORD(lParam), HIWORD(lParam));
+        return 0;
+
+    case WM_DPICHANGED: {
+        // The client size may change with the scale; pick it up from the window itself
+        RECT rc; GetClientRect(hWnd, &rc);
+        OnOutputResized(hWnd, rc.right - rc.left, rc.bottom - rc.top);
+        return 0;
+    }
+
+    case WM_DISPLAYCHANGE:
+        g_displayChanged = true;
+        return 0;
+
+    case WM_POWERBROADCAST:
+        if (wParam == PBT_POWERSETTINGCHANGE) OnPowerSettingChange((const POWERBROADCAST_SETTING*)lParam);
+        return TRUE;
+
     case WM_DESTROY: {
-        PostQuitMessage(0);
+        if (!g_retiringOutput) PostQuitMessage(0);
         return 0;
     }
 
@@ -804,9 +2340,9 @@ static void EnsureRegisteredClass(HINSTANCE hInst, const wchar_t* className, WND
     RegisterClassEx(&wcx);
 }
 
-// Per-monitor window creation callback
-static BOOL CALLBACK EnumMonitorsProc(HMONITOR, HDC, LPRECT lprcMonitor, LPARAM lParam) {
-    HINSTANCE hInstLocal = (HINSTANCE)lParam;
+// Create one monitor's popup window and DC (context setup follows separately)
+static bool CreateMonitorOutput(HINSTANCE hInstLocal, const RECT* lprcMonitor) {
+    if (g_monitorWindows.full()) return false;   // More monitors than outputs; the rest stay uncovered
 
     const int w = lprcMonitor->right - lprcMonitor->left;
     const int h = lprcMonitor->bottom - lprcMonitor->top;
@@ -816,7 +2352,7 @@ static BOOL CALLBACK EnumMonitorsProc(HMONITOR, HDC, LPRECT lprcMonitor, LPARAM
         lprcMonitor->left, lprcMonitor->top, w, h,
         NULL, NULL, hInstLocal, NULL
     );
-    if (!hWnd) return TRUE;
+    if (!hWnd) return false;
 
     // Enforce true topmost across all monitors
     SetWindowPos(hWnd, HWND_TOPMOST, lprcMonitor->left, lprcMonitor->top, w, h,
@@ -827,54 +2363,56 @@ static BOOL CALLBACK EnumMonitorsProc(HMONITOR, HDC, LPRECT lprcMonitor, LPARAM
 
     MonitorWindow mw{};
     mw.hWnd = hWnd;
+    mw.monitorRect = *lprcMonitor;
     mw.hDC = GetDC(hWnd);
-    if (!mw.hDC) return TRUE;
+    if (!mw.hDC) return false;
 
     SetWindowPixelFormat(mw.hDC);
 
-    mw.hGL = wglCreateContext(mw.hDC);
-    if (!mw.hGL) {
-        ReleaseDC(hWnd, mw.hDC);
-        return TRUE;
-    }
+    // GL context setup happens afterwards for all outputs at once (SetupOutputsParallel)
+    g_monitorWindows.push_back(mw);
+    if (!g_hWnd) g_hWnd = hWnd;
 
-    if (!wglMakeCurrent(mw.hDC, mw.hGL)) {
-        wglDeleteContext(mw.hGL);
-        ReleaseDC(hWnd, mw.hDC);
-        return TRUE;
-    }
+    return true;
+}
+
+// Per-monitor window creation callback
+static BOOL CALLBACK EnumMonitorsProc(HMONITOR, HDC, LPRECT lprcMonitor, LPARAM lParam) {
+    CreateMonitorOutput((HINSTANCE)lParam, lprcMonitor);
+    return TRUE;
+}
 
-    // Setup GL and resources per window (texture + quadric + projection)
-    SetupGL(mw, w, h);
+// Monitor rectangle collection callback (display topology changes)
+static BOOL CALLBACK CollectMonitorRectsProc(HMONITOR, HDC, LPRECT lprcMonitor, LPARAM lParam) {
+    ((FixedVector<RECT, MAX_OUTPUTS>*)lParam)->push_back(*lprcMonitor);
+    return TRUE;
+}
 
+// Seed a per-window ball once its bounds are known (idx staggers Extended mode)
+static void InitWindowBall(MonitorWindow& mw, int idx) {
     // Initialize per-window ball to a sensible starting point
-    mw.ballX = -0.5f;
-    mw.ballY = mw.floorY + BALL_RADIUS;
-    mw.ballZ = 0.0f;
-    mw.vx = 0.8f;
-    mw.vy = 4.5f;
-    mw.vz = 0.0f;
-    mw.spinAngle = 0.0f;
-    mw.spinDir = 1;
+    mw.ball.x = -0.5f;
+    mw.ball.y = mw.floorY + BALL_RADIUS;
+    mw.ball.z = 0.0f;
+    mw.ball.vx = 0.8f;
+    mw.ball.vy = 4.5f;
+    mw.ball.vz = 0.0f;
+    mw.ball.spin = 0.0f;
+    mw.ball.spinDir = 1;
 
     // Apply an offset in Extended mode so balls don't sync
-    if (g_multiMonitorMode == 1) {
-        int idx = (int)g_monitorWindows.size(); // 0 for first, 1 for second, etc.
-        mw.ballX += 0.5f * idx;   // shift starting X
-        mw.ballY += 0.2f * idx;   // shift starting Y
-        mw.vx += 0.1f * idx;      // tweak velocity slightly
+    if (g_settings.multiMonitorMode == 1) {
+        // idx is 0 for first, 1 for second, etc.
+        mw.ball.x += 0.5f * idx;   // shift starting X
+        mw.ball.y += 0.2f * idx;   // shift starting Y
+        mw.ball.vx += 0.1f * idx;      // tweak velocity slightly
     }
 
 	/*debugger******************************************************************************************************************************
-    if (g_multiMonitorMode == 1) {
-        DebugMode(L"EnumMonitorsProc Extended offset");
-        int idx = (int)g_monitorWindows.size();
+    if (g_settings.multiMonitorMode == 1) {
+        DebugMode(L"InitWindowBall Extended offset");
      }
     */
-    g_monitorWindows.push_back(mw);
-    if (!g_hWnd) g_hWnd = hWnd;
-
-    return TRUE;
 }
 
 // Create saver windows for all modes
@@ -894,40 +2432,42 @@ static HWND CreateSaverWindow(HINSTANCE hInst, HWND hParent, bool preview) {
         ShowWindow(hWnd, SW_SHOW);
         UpdateWindow(hWnd);
 
-        MonitorWindow mw{};
-        mw.hWnd = hWnd;
-        mw.hDC = GetDC(hWnd);
-        SetWindowPixelFormat(mw.hDC);
-        mw.hGL = wglCreateContext(mw.hDC);
-        wglMakeCurrent(mw.hDC, mw.hGL);
+        MonitorWindow newWindow{};
+        newWindow.hWnd = hWnd;
+        newWindow.monitorRect = rc;
+        newWindow.hDC = GetDC(hWnd);
+        SetWindowPixelFormat(newWindow.hDC);
+        g_monitorWindows.push_back(newWindow);
 
         // Setup GL and resources per window
-        int w = rc.right - rc.left;
-        int h = rc.bottom - rc.top;
-        SetupGL(mw, w, h);
+        SetupOutputsParallel();
+        if (g_monitorWindows.empty()) return nullptr;
+        MonitorWindow& mw = g_monitorWindows[0];
 
         // Initialize ball for preview (start near center to avoid floor intersection)
-        g_ballX = 0.0f;
-        g_ballY = (mw.floorY + BALL_RADIUS) + (fabs(mw.floorY) * 0.5f);
-        g_ballZ = 0.0f;
-        g_vx = 0.8f;
-        g_vy = 0.0f;
-        g_vz = 0.0f;
-        g_spinAngle = 0.0f;
-        g_spinDir = 1;
-
-        mw.ballX = g_ballX;
-        mw.ballY = g_ballY;
-        mw.ballZ = g_ballZ;
-        mw.vx = g_vx;
-        mw.vy = g_vy;
-        mw.vz = g_vz;
-        mw.spinAngle = g_spinAngle;
-        mw.spinDir = g_spinDir;
-
-        g_monitorWindows.push_back(mw);
+        g_ball.x = 0.0f;
+        g_ball.y = (mw.floorY + BALL_RADIUS) + (fabs(mw.floorY) * 0.5f);
+        g_ball.z = 0.0f;
+        g_ball.vx = 0.8f;
+        g_ball.vy = 0.0f;
+        g_ball.vz = 0.0f;
+        g_ball.spin = 0.0f;
+        g_ball.spinDir = 1;
+
+        mw.ball.x = g_ball.x;
+        mw.ball.y = g_ball.y;
+        mw.ball.z = g_ball.z;
+        mw.ball.vx = g_ball.vx;
+        mw.ball.vy = g_ball.vy;
+        mw.ball.vz = g_ball.vz;
+        mw.ball.spin = g_ball.spin;
+        mw.ball.spinDir = g_ball.spinDir;
+
         if (!g_hWnd) g_hWnd = hWnd;
 
+        // A spanned world in preview is just the one small window
+        SyncWorldBounds();
+
         return hWnd;
     }
     else {
@@ -936,23 +2476,33 @@ static HWND CreateSaverWindow(HINSTANCE hInst, HWND hParent, bool preview) {
 		/*Debugger*************************************************************************************************************************************
         DebugMode(L"CreateSaverWindow before switch");
         */
-        switch (g_multiMonitorMode) {
+        switch (g_settings.multiMonitorMode) {
         case 1: // Extended (independent physics per monitor) — intentional fallthrough to case 2 for window creation
             // (No break here: both Extended and Replicated enumerate one popup per monitor)
         case 2: // Replicated (global physics rendered on all monitors)
+        case 4: // Spanned (global physics in one world laid out across all monitors)
         {
             g_monitorWindows.clear();
             EnumDisplayMonitors(NULL, NULL, EnumMonitorsProc, (LPARAM)hInst);
 
+            // Contexts for every monitor are set up together, then each window's ball is seeded
+            SetupOutputsParallel();
+            for (size_t i = 0; i < g_monitorWindows.size(); ++i) {
+                InitWindowBall(g_monitorWindows[i], (int)i);
+            }
+
+            // Spanned mode places each window's slice of the world by its monitor rectangle
+            SyncWorldBounds();
+
             // Initialize global ball state for replicated mode; bounds derived from first window per-frame
-            g_ballX = -0.5f;
-            g_ballY = 0.0f;
-            g_ballZ = 0.0f;
-            g_vx = 0.8f;
-            g_vy = 4.5f;
-            g_vz = 0.0f;
-            g_spinAngle = 0.0f;
-            g_spinDir = 1;
+            g_ball.x = -0.5f;
+            g_ball.y = 0.0f;
+            g_ball.z = 0.0f;
+            g_ball.vx = 0.8f;
+            g_ball.vy = 4.5f;
+            g_ball.vz = 0.0f;
+            g_ball.spin = 0.0f;
+            g_ball.spinDir = 1;
 
             return g_hWnd;
         }
@@ -972,25 +2522,17 @@ static HWND CreateSaverWindow(HINSTANCE hInst, HWND hParent, bool preview) {
             ShowWindow(hWnd, SW_SHOW);
             UpdateWindow(hWnd);
 
-            MonitorWindow mw{};
-            mw.hWnd = hWnd;
-            mw.hDC = GetDC(hWnd);
-            SetWindowPixelFormat(mw.hDC);
-            mw.hGL = wglCreateContext(mw.hDC);
-            wglMakeCurrent(mw.hDC, mw.hGL);
-
-            SetupGL(mw, w, h);
-
-            mw.ballX = -0.5f;
-            mw.ballY = mw.floorY + BALL_RADIUS;
-            mw.ballZ = 0.0f;
-            mw.vx = 0.8f;
-            mw.vy = 4.5f;
-            mw.vz = 0.0f;
-            mw.spinAngle = 0.0f;
-            mw.spinDir = 1;
-
-            g_monitorWindows.push_back(mw);
+            MonitorWindow newWindow{};
+            newWindow.hWnd = hWnd;
+            newWindow.monitorRect = { x, y, x + w, y + h };
+            newWindow.hDC = GetDC(hWnd);
+            SetWindowPixelFormat(newWindow.hDC);
+            g_monitorWindows.push_back(newWindow);
+
+            SetupOutputsParallel();
+            if (g_monitorWindows.empty()) return nullptr;
+            InitWindowBall(g_monitorWindows[0], 0);
+
             g_hWnd = hWnd;
             return g_hWnd;
         }
@@ -1009,35 +2551,37 @@ static HWND CreateSaverWindow(HINSTANCE hInst, HWND hParent, bool preview) {
             ShowWindow(hWnd, SW_SHOW);
             UpdateWindow(hWnd);
 
-            MonitorWindow mw{};
-            mw.hWnd = hWnd;
-            mw.hDC = GetDC(hWnd);
-            SetWindowPixelFormat(mw.hDC);
-            mw.hGL = wglCreateContext(mw.hDC);
-            wglMakeCurrent(mw.hDC, mw.hGL);
+            MonitorWindow newWindow{};
+            newWindow.hWnd = hWnd;
+            newWindow.monitorRect = rcDesk;
+            newWindow.hDC = GetDC(hWnd);
+            SetWindowPixelFormat(newWindow.hDC);
+            g_monitorWindows.push_back(newWindow);
 
-            SetupGL(mw, w, h);
+            SetupOutputsParallel();
+            if (g_monitorWindows.empty()) return nullptr;
+            MonitorWindow& mw = g_monitorWindows[0];
 
             // Seed both global and per-window state near center (avoid immediate floor clamp)
-            g_ballX = 0.0f;
-            g_ballY = (mw.floorY + BALL_RADIUS) + (fabs(mw.floorY) * 0.5f);
-            g_ballZ = 0.0f;
-            g_vx = 0.8f;
-            g_vy = 0.0f;
-            g_vz = 0.0f;
-            g_spinAngle = 0.0f;
-            g_spinDir = 1;
-
-            mw.ballX = g_ballX;
-            mw.ballY = g_ballY;
-            mw.ballZ = g_ballZ;
-            mw.vx = g_vx;
-            mw.vy = g_vy;
-            mw.vz = g_vz;
-            mw.spinAngle = g_spinAngle;
-            mw.spinDir = g_spinDir;
-
-            g_monitorWindows.push_back(mw);
+            g_ball.x = 0.0f;
+            g_ball.y = (mw.floorY + BALL_RADIUS) + (fabs(mw.floorY) * 0.5f);
+            g_ball.z = 0.0f;
+            g_ball.vx = 0.8f;
+            g_ball.vy = 0.0f;
+            g_ball.vz = 0.0f;
+            g_ball.spin = 0.0f;
+            g_ball.spinDir = 1;
+
+            mw.ball.x = g_ball.x;
+            mw.ball.y = g_ball.y;
+            mw.ball.z = g_ball.z;
+            mw.ball.vx = g_ball.vx;
+            mw.ball.vy = g_ball.vy;
+            mw.ball.vz = g_ball.vz;
+            mw.ball.spin = g_ball.spin;
+            mw.ball.spinDir = g_ball.spinDir;
+
+            SyncWorldBounds();
             g_hWnd = hWnd;
             return g_hWnd;
         }
@@ -1047,20 +2591,96 @@ static HWND CreateSaverWindow(HINSTANCE hInst, HWND hParent, bool preview) {
     return nullptr;
 }
 
+// Display topology changed: rebuild only the outputs whose monitor appeared, vanished or moved
+// Outputs on unchanged monitors keep their context, resources and ball.
+static void RebuildOutputsForDisplayChange(HINSTANCE hInst) {
+    g_displayChanged = false;
+    NoteExpectedAllocations();
+    g_recordLayoutDirty = g_recordLayoutFresh = true;
+    g_particles.Clear();   // World indices follow the output list
+    if (g_preview || g_monitorWindows.empty()) return;   // Preview follows its host via WM_SIZE
+
+    const int mode = g_settings.multiMonitorMode;
+    if (mode == 0 || mode == 3) {
+        // One window covering the desktop (Single) or the virtual screen (Unified): just move it
+        MonitorWindow& mw = g_monitorWindows[0];
+        RECT rc;
+        if (mode == 0) {
+            GetWindowRect(GetDesktopWindow(), &rc);
+        }
+        else {
+            rc.left = GetSystemMetrics(SM_XVIRTUALSCREEN);
+            rc.top = GetSystemMetrics(SM_YVIRTUALSCREEN);
+            rc.right = rc.left + GetSystemMetrics(SM_CXVIRTUALSCREEN);
+            rc.bottom = rc.top + GetSystemMetrics(SM_CYVIRTUALSCREEN);
+        }
+        if (EqualRect(&rc, &mw.monitorRect)) return;
+        mw.monitorRect = rc;
+        SetWindowPos(mw.hWnd, HWND_TOPMOST, rc.left, rc.top, rc.right - rc.left, rc.bottom - rc.top,
+            SWP_SHOWWINDOW | SWP_NOACTIVATE);   // WM_SIZE refreshes the cached view
+        CloseFrameExport(mw);                   // Ring slots are sized for the old rectangle
+        OpenFrameExport(mw);
+        return;
+    }
+
+    FixedVector<RECT, MAX_OUTPUTS> monitors;
+    EnumDisplayMonitors(NULL, NULL, CollectMonitorRectsProc, (LPARAM)&monitors);
+    bool covered[MAX_OUTPUTS] = {};
+
+    // Retire outputs whose monitor rectangle is gone
+    g_retiringOutput = true;
+    for (size_t i = 0; i < g_monitorWindows.size();) {
+        bool found = false;
+        for (size_t m = 0; m < monitors.size(); ++m) {
+            if (!covered[m] && EqualRect(&monitors[m], &g_monitorWindows[i].monitorRect)) {
+                covered[m] = true;
+                found = true;
+                break;
+            }
+        }
+        if (found) { ++i; continue; }
+        ReleaseOutput(g_monitorWindows[i]);
+        g_monitorWindows.erase(g_monitorWindows.begin() + i);
+    }
+    g_retiringOutput = false;
+
+    // Bring up outputs for new monitors
+    for (size_t m = 0; m < monitors.size(); ++m) {
+        if (covered[m]) continue;
+        if (!CreateMonitorOutput(hInst, &monitors[m])) continue;
+        MonitorWindow& mw = g_monitorWindows.back();
+        if (!SetupOutputContext(mw)) {
+            g_retiringOutput = true;
+            ReleaseOutput(mw);
+            g_retiringOutput = false;
+            g_monitorWindows.pop_back();
+            continue;
+        }
+        InitWindowBall(mw, (int)g_monitorWindows.size() - 1);
+    }
+
+    if (g_monitorWindows.empty()) {
+        g_hWnd = nullptr;
+        g_running = false;
+        return;
+    }
+    g_hWnd = g_monitorWindows[0].hWnd;
+    g_hDC = g_monitorWindows[0].hDC;
+    OpenFrameExports();
+    SyncWorldBounds();
+}
+
 // Cleanup: per-monitor resources and contexts — no sharing, no master
 static void CleanupGL() {
+    size_t gpuBytes = 0;
     for (auto& mw : g_monitorWindows) {
-        if (mw.hDC && mw.hGL) {
-            if (wglMakeCurrent(mw.hDC, mw.hGL)) {
-                if (mw.checkerTex) { glDeleteTextures(1, &mw.checkerTex); mw.checkerTex = 0; }
-                if (mw.quadric) { gluDeleteQuadric(mw.quadric); mw.quadric = nullptr; }
-                wglMakeCurrent(NULL, NULL);
-            }
-        }
-        if (mw.hGL) { wglDeleteContext(mw.hGL); mw.hGL = nullptr; }
-        if (mw.hDC) { ReleaseDC(mw.hWnd, mw.hDC); mw.hDC = nullptr; }
-        if (mw.hWnd) { DestroyWindow(mw.hWnd); mw.hWnd = nullptr; }
+        gpuBytes += OutputGpuBytes(mw);
+        ReleaseOutput(mw);
     }
+    char msg[128];
+    snprintf(msg, sizeof(msg), "BoingBallSaver: released %zu outputs, %.1f KB of GPU assets\n",
+        g_monitorWindows.size(), (double)gpuBytes / 1024.0);
+    OutputDebugStringA(msg);
     g_monitorWindows.clear();
 
     if (g_hDC) { ReleaseDC(g_hWnd, g_hDC); g_hDC = nullptr; }
@@ -1073,7 +2693,19 @@ static void CleanupGL() {
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
     g_hInst = hInstance;
 
-    const wchar_t* cmd = lpCmdLine;
+    // Run recording (/record <file>) takes the rest of the line; the mode switches are read before it
+    wchar_t cmdBuf[1024] = L"";
+    wchar_t recordPath[MAX_PATH] = L"";
+    if (lpCmdLine) wcsncpy_s(cmdBuf, lpCmdLine, _TRUNCATE);
+    if (wchar_t* rec = wcsstr(cmdBuf, L"/record")) {
+        const wchar_t* path = rec + 7;
+        while (*path == L' ' || *path == L'"') path++;
+        wcsncpy_s(recordPath, path, _TRUNCATE);
+        size_t len = wcslen(recordPath);
+        while (len && (recordPath[len - 1] == L' ' || recordPath[len - 1] == L'"')) recordPath[--len] = L'\0';
+        *rec = L'\0';
+    }
+    const wchar_t* cmd = cmdBuf;
 
     // Settings dialog
     if (cmd && (wcsstr(cmd, L"/c") || wcsstr(cmd, L"-c"))) {
@@ -1093,10 +2725,18 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
     }
 
     // Load settings before creating any windows so mode is correct for CreateSaverWindow
-    LoadSettingsFromRegistry();
+    StartupBegin();
+    g_settings = LoadSettingsFromRegistry();
+    g_jobs.Start(g_settings.workerThreads);
+    StartupMark(STARTUP_SETTINGS);
+
+    // Shared textures and meshes are built while the windows are created
+    StartAssetPreparation();
 
     g_hWnd = CreateSaverWindow(hInstance, hWndParent, hWndParent != nullptr);
 
+    FinishAssetPreparation();   // Never leave the worker running (e.g. window creation failed early)
+
     if (!g_hWnd) {
         MessageBox(nullptr, L"Failed to create window!", L"BoingBallSaver", MB_OK | MB_ICONERROR);
         return 1;
@@ -1107,41 +2747,65 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
     if (!g_preview && !g_cursorHidden) { ShowCursor(FALSE); g_cursorHidden = true; }
 
     InitTimer();
+    StartPacing();
+
+    if (recordPath[0] && !g_preview) {
+        FILE* fp = nullptr;
+        if (_wfopen_s(&fp, recordPath, L"wb") == 0) g_recorder.Open(fp, CurrentSimParams(), g_settings);
+    }
 
-    MSG msg;
     while (g_running) {
-        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-            if (msg.message == WM_QUIT) g_running = false;
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+        BeginFrameAllocations();
+
+        PumpMessages();
+        if (g_displayChanged && g_running) {
+            RebuildOutputsForDisplayChange(hInstance);
+            ConfigurePacing();      // The refresh rate may have changed with the monitors
+            WatchPowerState();      // ...and the primary window with them
+        }
+
+        // Preview replays a cached cycle and sleeps until the next frame is due
+        if (g_preview && !g_monitorWindows.empty() && PresentPreviewFrame(g_monitorWindows[0])) {
+            ReportStartupTimeline();
+            EndFrameAllocations();
+            Sleep(PreviewFrameWaitMs());
+            continue;
+        }
+
+        // Display off: no simulation (under the dt clamp it would only crawl) and no drawing; the
+        // loop keeps a slow cadence for display changes and telemetry
+        const PacingCadence cadence = ChooseCadence(g_power, g_settings.lowPower);
+        if (cadence == CADENCE_HIDDEN) {
+            ComputeDeltaTime();     // Keep the clock current so the first visible frame is a normal step
+            for (auto& mw : g_monitorWindows) mw.framePresented = false;
+            EndFrameAllocations();
+            ReportTelemetry();
+            WaitForNextFrame(cadence);
+            continue;
         }
 
         g_soundPlayedThisFrame = false;
         float dt = ComputeDeltaTime();
+        g_powerCounters.frames++;
+        RecordTick(dt * g_timeScale);
 
 		/*debugger*********************************************************************************************************************************
         DebugMode(L"Main loop top");
         */
-        // Refresh global bounds and advance global physics for Replicated and Single
-        if (g_multiMonitorMode == 2 || g_multiMonitorMode == 0) {
+        // Advance global physics for Replicated, Single and Spanned
+        // (global bounds are kept current by SyncWorldBounds when an output is resized)
+        if (g_settings.multiMonitorMode == 2 || g_settings.multiMonitorMode == 0 ||
+            g_settings.multiMonitorMode == 4) {
 			/*debugger*************************************************************************************************************************
-            DebugMode(L"Main loop bounds update (Single/Replicated path)");
+            DebugMode(L"Main loop global physics (Single/Replicated/Spanned path)");
             */
-            if (!g_monitorWindows.empty()) {
-                RECT rc; GetClientRect(g_monitorWindows[0].hWnd, &rc);
-                MonitorWindow& first = g_monitorWindows[0];
-                // Make current so projection-related state and bounds are valid
-                wglMakeCurrent(first.hDC, first.hGL);
-                ApplyViewportAndProjection(first, rc.right - rc.left, rc.bottom - rc.top);
-                g_WALL_X = first.wallX;
-                g_WALL_Z = first.wallZ;
-                g_FLOOR_Y = first.floorY;
-            }
             UpdatePhysicsGlobal(dt * g_timeScale);
         }
+        UpdateParticles(dt * g_timeScale);
+        g_particleThrottle.NoteFrameTime(g_frameWorkMs);   // Work only: paced frames sleep the rest
 
         for (auto& mw : g_monitorWindows) {
-            switch (g_multiMonitorMode) { //debuggers below**************************************************************
+            switch (g_settings.multiMonitorMode) { //debuggers below**************************************************************
             case 1: // Extended
                 /*DebugMode(L"Render loop Extended");*/
                 RenderFrameMonitor(mw, false, dt);
@@ -1154,6 +2818,9 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
                 /*DebugMode(L"Render loop Unified");*/
                 RenderFrameMonitor(mw, false, dt);
                 break;
+            case 4: // Spanned (monitors the ball is not on skip draw and present)
+                RenderFrameMonitor(mw, true, dt);
+                break;
             default: // Single
                 /*DebugMode(L"Render loop Single");*/
                 RenderFrameMonitor(mw, true, dt);
@@ -1161,11 +2828,18 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
             }
         }
 
-        Sleep(1);
+        ReportStartupTimeline();
+        EndFrameAllocations();
+        ReportTelemetry();
+        WaitForNextFrame(cadence);
     }
 
     // Final cleanup
+    g_recorder.Close();
+    StopPacing();
     CleanupGL();
+    UnmapAssetPack();
+    g_jobs.Stop();
     return 0;
 }
 
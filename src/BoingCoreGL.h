@@ -0,0 +1,758 @@
+// BoingCoreGL.h — core-profile (GL 3.3) renderer: shaders, vertex arrays and a persistent-mapped
+// per-frame buffer, as an alternative to the saver's fixed-function path
+// Portable (no Windows headers, nothing to link): include <GL/gl.h> first. Every entry point, GL 1.1
+// ones included, comes through a loader callback (wglGetProcAddress/opengl32 in the saver,
+// eglGetProcAddress in tools/BoingGolden.cpp), so the headless check on Mesa runs this very code.
+// Frames come from BoingScene.h like the other two renderers; a batch's balls and shadows are
+// one instanced draw fed from the per-frame buffer. By design the ball is lit per pixel,
+// its checker is computed in the shader (box-filtered over each pixel's footprint instead of
+// mip-mapped) and the grid's wide lines are widened in the vertex shader.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "BoingAssets.h"
+#include "BoingParticles.h"
+#include "BoingScene.h"
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Types and enums newer than GL 1.1 (all Windows' own GL header has)
+#ifndef GL_VERSION_1_5
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+#endif
+#ifndef GL_VERSION_2_0
+typedef char GLchar;
+#endif
+#ifndef GL_VERSION_3_2
+typedef struct __GLsync* GLsync;
+typedef uint64_t GLuint64;
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STREAM_DRAW 0x88E0
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_VERTEX_SHADER 0x8B31
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_LINK_STATUS 0x8B82
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_UNIFORM_BUFFER
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif
+#ifndef GL_MAJOR_VERSION
+#define GL_MAJOR_VERSION 0x821B
+#define GL_MINOR_VERSION 0x821C
+#define GL_NUM_EXTENSIONS 0x821D
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_PROGRAM_POINT_SIZE
+#define GL_PROGRAM_POINT_SIZE 0x8642
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_WAIT_FAILED 0x911D
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+typedef void* (*CoreGLGetProc)(const char* name);
+
+// The entry points the core renderer uses, fetched once per context
+struct CoreGL {
+    // GL 1.1
+    void (APIENTRY* Viewport)(GLint, GLint, GLsizei, GLsizei) = nullptr;
+    void (APIENTRY* ClearColor)(GLfloat, GLfloat, GLfloat, GLfloat) = nullptr;
+    void (APIENTRY* Clear)(GLbitfield) = nullptr;
+    void (APIENTRY* Enable)(GLenum) = nullptr;
+    void (APIENTRY* Disable)(GLenum) = nullptr;
+    void (APIENTRY* BlendFunc)(GLenum, GLenum) = nullptr;
+    void (APIENTRY* DepthFunc)(GLenum) = nullptr;
+    void (APIENTRY* DepthMask)(GLboolean) = nullptr;
+    void (APIENTRY* DrawArrays)(GLenum, GLint, GLsizei) = nullptr;
+    void (APIENTRY* DrawElements)(GLenum, GLsizei, GLenum, const void*) = nullptr;
+    void (APIENTRY* GetIntegerv)(GLenum, GLint*) = nullptr;
+    const GLubyte* (APIENTRY* GetString)(GLenum) = nullptr;
+    // GL 1.5
+    void (APIENTRY* GenBuffers)(GLsizei, GLuint*) = nullptr;
+    void (APIENTRY* DeleteBuffers)(GLsizei, const GLuint*) = nullptr;
+    void (APIENTRY* BindBuffer)(GLenum, GLuint) = nullptr;
+    void (APIENTRY* BufferData)(GLenum, GLsizeiptr, const void*, GLenum) = nullptr;
+    void (APIENTRY* BufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*) = nullptr;
+    // GL 2.0
+    GLuint (APIENTRY* CreateShader)(GLenum) = nullptr;
+    void (APIENTRY* ShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = nullptr;
+    void (APIENTRY* CompileShader)(GLuint) = nullptr;
+    void (APIENTRY* GetShaderiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY* GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
+    void (APIENTRY* DeleteShader)(GLuint) = nullptr;
+    GLuint (APIENTRY* CreateProgram)() = nullptr;
+    void (APIENTRY* AttachShader)(GLuint, GLuint) = nullptr;
+    void (APIENTRY* LinkProgram)(GLuint) = nullptr;
+    void (APIENTRY* GetProgramiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY* GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
+    void (APIENTRY* DeleteProgram)(GLuint) = nullptr;
+    void (APIENTRY* UseProgram)(GLuint) = nullptr;
+    void (APIENTRY* EnableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY* VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = nullptr;
+    // GL 3.0 - 3.2
+    void (APIENTRY* GenVertexArrays)(GLsizei, GLuint*) = nullptr;
+    void (APIENTRY* DeleteVertexArrays)(GLsizei, const GLuint*) = nullptr;
+    void (APIENTRY* BindVertexArray)(GLuint) = nullptr;
+    void (APIENTRY* DrawElementsInstanced)(GLenum, GLsizei, GLenum, const void*, GLsizei) = nullptr;
+    void (APIENTRY* BindBufferRange)(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr) = nullptr;
+    void* (APIENTRY* MapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = nullptr;
+    GLboolean (APIENTRY* UnmapBuffer)(GLenum) = nullptr;
+    const GLubyte* (APIENTRY* GetStringi)(GLenum, GLuint) = nullptr;
+    GLuint (APIENTRY* GetUniformBlockIndex)(GLuint, const GLchar*) = nullptr;
+    void (APIENTRY* UniformBlockBinding)(GLuint, GLuint, GLuint) = nullptr;
+    GLsync (APIENTRY* FenceSync)(GLenum, GLbitfield) = nullptr;
+    GLenum (APIENTRY* ClientWaitSync)(GLsync, GLbitfield, GLuint64) = nullptr;
+    void (APIENTRY* DeleteSync)(GLsync) = nullptr;
+    // GL 4.4 or ARB_buffer_storage (optional)
+    void (APIENTRY* BufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield) = nullptr;
+
+    // False if any required entry point is missing
+    bool Load(CoreGLGetProc getProc) {
+        bool ok = true;
+#define CORE_GL_FETCH(name) ok &= Fetch(getProc, "gl" #name, name)
+        CORE_GL_FETCH(Viewport); CORE_GL_FETCH(ClearColor); CORE_GL_FETCH(Clear); CORE_GL_FETCH(Enable);
+        CORE_GL_FETCH(Disable); CORE_GL_FETCH(BlendFunc); CORE_GL_FETCH(DepthFunc); CORE_GL_FETCH(DepthMask);
+        CORE_GL_FETCH(DrawArrays); CORE_GL_FETCH(DrawElements); CORE_GL_FETCH(GetIntegerv); CORE_GL_FETCH(GetString);
+        CORE_GL_FETCH(GenBuffers); CORE_GL_FETCH(DeleteBuffers); CORE_GL_FETCH(BindBuffer); CORE_GL_FETCH(BufferData);
+        CORE_GL_FETCH(BufferSubData);
+        CORE_GL_FETCH(CreateShader); CORE_GL_FETCH(ShaderSource); CORE_GL_FETCH(CompileShader);
+        CORE_GL_FETCH(GetShaderiv); CORE_GL_FETCH(GetShaderInfoLog); CORE_GL_FETCH(DeleteShader);
+        CORE_GL_FETCH(CreateProgram); CORE_GL_FETCH(AttachShader); CORE_GL_FETCH(LinkProgram);
+        CORE_GL_FETCH(GetProgramiv); CORE_GL_FETCH(GetProgramInfoLog); CORE_GL_FETCH(DeleteProgram);
+        CORE_GL_FETCH(UseProgram); CORE_GL_FETCH(EnableVertexAttribArray); CORE_GL_FETCH(VertexAttribPointer);
+        CORE_GL_FETCH(GenVertexArrays); CORE_GL_FETCH(DeleteVertexArrays); CORE_GL_FETCH(BindVertexArray);
+        CORE_GL_FETCH(DrawElementsInstanced);
+        CORE_GL_FETCH(BindBufferRange); CORE_GL_FETCH(MapBufferRange); CORE_GL_FETCH(UnmapBuffer);
+        CORE_GL_FETCH(GetStringi); CORE_GL_FETCH(GetUniformBlockIndex); CORE_GL_FETCH(UniformBlockBinding);
+        CORE_GL_FETCH(FenceSync); CORE_GL_FETCH(ClientWaitSync); CORE_GL_FETCH(DeleteSync);
+#undef CORE_GL_FETCH
+        Fetch(getProc, "glBufferStorage", BufferStorage);
+        return ok;
+    }
+
+private:
+    template <typename Fn>
+    static bool Fetch(CoreGLGetProc getProc, const char* name, Fn& fn) {
+        fn = (Fn)getProc(name);
+        return fn != nullptr;
+    }
+};
+
+// Sphere instances per draw: every ball and both its shadows at the batch's capacity
+const size_t CORE_MAX_INSTANCES = 3 * BALL_BATCH_CAPACITY;
+#define CORE_GLSL_MAX_INSTANCES "48"
+static_assert(CORE_MAX_INSTANCES == 48, "CORE_GLSL_MAX_INSTANCES must match CORE_MAX_INSTANCES");
+
+// Shaders (GLSL 3.30). Both uniform blocks are std140 and mirror CoreFrameBlock / CoreDrawBlock;
+// Draw holds one element per instance, and draws that are not instanced use the first.
+#define CORE_GLSL_BLOCKS \
+    "#version 330 core\n" \
+    "layout(std140) uniform Frame {\n" \
+    "    mat4 uProjection;\n" \
+    "    vec4 uLightDir;\n"      /* Eye space, unit length */ \
+    "    vec4 uAmbient;\n"       /* Material ambient x (global + light ambient) */ \
+    "    vec4 uDiffuse;\n"       /* Material diffuse x light diffuse */ \
+    "    vec4 uViewport;\n"      /* Width, height, line width, point size (pixels) */ \
+    "};\n" \
+    "struct DrawData {\n" \
+    "    mat4 modelview;\n" \
+    "    vec4 color;\n" \
+    "    vec4 shade;\n"          /* x: CORE_SHADE_* */ \
+    "};\n" \
+    "layout(std140) uniform Draw {\n" \
+    "    DrawData uDraw[" CORE_GLSL_MAX_INSTANCES "];\n" \
+    "};\n"
+
+// Sphere meshes: the balls and both their shadows, one instance each
+static const char CORE_MESH_VS[] = CORE_GLSL_BLOCKS
+    "layout(location = 0) in vec3 aPosition;\n"
+    "layout(location = 1) in vec3 aNormal;\n"
+    "layout(location = 2) in vec2 aTexCoord;\n"
+    "out vec3 vNormal;\n"
+    "out vec2 vTexCoord;\n"
+    "flat out vec4 vColor;\n"
+    "flat out float vShade;\n"
+    "void main() {\n"
+    "    mat4 modelview = uDraw[gl_InstanceID].modelview;\n"
+    "    vNormal = mat3(modelview) * aNormal;\n"
+    "    vTexCoord = aTexCoord;\n"
+    "    vColor = uDraw[gl_InstanceID].color;\n"
+    "    vShade = uDraw[gl_InstanceID].shade.x;\n"
+    "    gl_Position = uProjection * (modelview * vec4(aPosition, 1.0));\n"
+    "}\n";
+
+// The checker is the texture's 16 x 8 squares (red where the square indices sum to even). Each
+// channel's square wave is integrated over the pixel's footprint, so edges fade over exactly one
+// pixel at any distance and the pattern turns to its average instead of aliasing near the rim.
+static const char CORE_MESH_FS[] = CORE_GLSL_BLOCKS
+    "in vec3 vNormal;\n"
+    "in vec2 vTexCoord;\n"
+    "flat in vec4 vColor;\n"
+    "flat in float vShade;\n"
+    "out vec4 oColor;\n"
+    "const vec3 CHECKER_RED = vec3(220.0, 30.0, 30.0) / 255.0;\n"
+    "const vec3 CHECKER_WHITE = vec3(240.0, 240.0, 240.0) / 255.0;\n"
+    "float Checker(vec2 p) {\n"
+    "    vec2 w = fwidth(p) + 1e-4;\n"
+    "    vec2 i = 2.0 * (abs(fract((p - 0.5 * w) * 0.5) - 0.5) - abs(fract((p + 0.5 * w) * 0.5) - 0.5)) / w;\n"
+    "    return 0.5 - 0.5 * i.x * i.y;\n"
+    "}\n"
+    "void main() {\n"
+    "    if (vShade < 0.5) { oColor = vColor; return; }\n"
+    "    vec3 texel = mix(CHECKER_RED, CHECKER_WHITE, Checker(vTexCoord * vec2(16.0, 8.0)));\n"
+    "    vec3 light = vColor.rgb;\n"
+    "    if (vShade > 1.5) {\n"
+    "        float d = max(dot(normalize(vNormal), uLightDir.xyz), 0.0);\n"
+    "        light = min(uAmbient.rgb + d * uDiffuse.rgb, vec3(1.0));\n"
+    "    }\n"
+    "    oColor = vec4(light * texel, vColor.a);\n"
+    "}\n";
+
+// Grid lines as quads: every corner knows both ends of its line and spreads along the minor axis
+// of the line on screen, the way GL rasterizes wide lines
+static const char CORE_GRID_VS[] = CORE_GLSL_BLOCKS
+    "layout(location = 0) in vec3 aPosition;\n"
+    "layout(location = 1) in vec3 aOther;\n"
+    "layout(location = 2) in float aSide;\n"
+    "void main() {\n"
+    "    vec4 a = uProjection * (uDraw[0].modelview * vec4(aPosition, 1.0));\n"
+    "    vec4 b = uProjection * (uDraw[0].modelview * vec4(aOther, 1.0));\n"
+    "    vec2 d = (b.xy / b.w - a.xy / a.w) * uViewport.xy;\n"
+    "    vec2 axis = abs(d.x) >= abs(d.y) ? vec2(0.0, 1.0) : vec2(1.0, 0.0);\n"
+    "    gl_Position = a + vec4(axis * aSide * uViewport.z / uViewport.xy * a.w, 0.0, 0.0);\n"
+    "}\n";
+
+static const char CORE_FLAT_FS[] = CORE_GLSL_BLOCKS
+    "out vec4 oColor;\n"
+    "void main() { oColor = uDraw[0].color; }\n";
+
+static const char CORE_PARTICLE_VS[] = CORE_GLSL_BLOCKS
+    "layout(location = 0) in vec4 aColor;\n"
+    "layout(location = 1) in vec3 aPosition;\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    vColor = aColor;\n"
+    "    gl_PointSize = uViewport.w;\n"
+    "    gl_Position = uProjection * (uDraw[0].modelview * vec4(aPosition, 1.0));\n"
+    "}\n";
+
+static const char CORE_PARTICLE_FS[] = CORE_GLSL_BLOCKS
+    "in vec4 vColor;\n"
+    "out vec4 oColor;\n"
+    "void main() { oColor = vColor; }\n";
+
+#undef CORE_GLSL_BLOCKS
+#undef CORE_GLSL_MAX_INSTANCES
+
+enum CoreShade {
+    CORE_SHADE_FLAT = 0,        // uColor
+    CORE_SHADE_CHECKER = 1,     // uColor x checker
+    CORE_SHADE_LIT_CHECKER = 2  // Per-pixel lighting x checker
+};
+
+struct CoreFrameBlock {
+    float projection[16];
+    float lightDir[4];
+    float ambient[4];
+    float diffuse[4];
+    float viewport[4];
+};
+
+struct CoreDrawBlock {
+    float modelview[16];
+    float color[4];
+    float shade[4];
+};
+static_assert(sizeof(CoreDrawBlock) % 16 == 0, "CoreDrawBlock must match the std140 array stride");
+
+// One output's frame: the balls come as the saver's structure-of-arrays batch
+struct CoreScene {
+    int   width = 0, height = 0;
+    float clear[3] = {};
+    bool  grid = true, floorShadow = true, wallShadow = true, lighting = true;
+    int   geometry = 1;                  // Settings geometry mode: 0 = smooth, 1 = classic
+    float floorY = -1.0f;                // Grid floor
+    const float* ballX = nullptr;
+    const float* ballY = nullptr;
+    const float* ballZ = nullptr;
+    const float* ballSpin = nullptr;
+    const float* ballFloorY = nullptr;   // Floor shadow plane under each ball
+    size_t ballCount = 0;
+    const ParticleVertex* particles = nullptr;
+    size_t particleCount = 0;
+    float  particleOffsetX = 0.0f;       // Camera shift for the particles (spanned outputs)
+};
+
+struct CoreStats {
+    uint64_t frames = 0;
+    uint64_t draws = 0;
+    uint64_t instances = 0;        // Spheres drawn by the instanced draws
+    uint64_t streamBytes = 0;      // Per-frame data written to the stream buffer
+    uint64_t fenceWaits = 0;       // Frames that found their region still in use by the GPU
+    uint64_t uploads = 0;          // Static buffers built: sphere LODs on first use, the grid per floor height
+};
+
+const int    CORE_GL_MAJOR = 3, CORE_GL_MINOR = 3;
+const int    CORE_FRAMES_IN_FLIGHT = 3;     // Stream buffer regions, each fenced after its frame
+const size_t CORE_MAX_DRAWS = 8;            // Grid, the instanced spheres, particles (and spare)
+const size_t CORE_MAX_GRID_LINES = 64;
+
+class CoreRenderer {
+public:
+    // Set up on the current context: entry points, programs, static buffers and the stream buffer.
+    // On failure everything created is deleted again and Error() says why.
+    bool Init(CoreGLGetProc getProc, const SharedAssets& assets, bool allowPersistent = true) {
+        Forget();
+        assets_ = &assets;
+        if (!gl_.Load(getProc)) return Fail("missing GL 3.3 entry points");
+        GLint major = 0, minor = 0;
+        gl_.GetIntegerv(GL_MAJOR_VERSION, &major);
+        gl_.GetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major * 10 + minor < CORE_GL_MAJOR * 10 + CORE_GL_MINOR) return Fail("GL 3.3 not available");
+
+        meshProgram_ = BuildProgram(CORE_MESH_VS, CORE_MESH_FS);
+        if (meshProgram_) gridProgram_ = BuildProgram(CORE_GRID_VS, CORE_FLAT_FS);
+        if (gridProgram_) particleProgram_ = BuildProgram(CORE_PARTICLE_VS, CORE_PARTICLE_FS);
+        if (!particleProgram_) { Release(); return false; }
+
+        // Stream buffer: this frame's blocks, then its particles, one region per frame in flight
+        GLint align = 256;
+        gl_.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+        align_ = (align > (GLint)sizeof(ParticleVertex)) ? (size_t)align : sizeof(ParticleVertex);   // Regions stay whole vertices
+        drawOffset_ = AlignUp(sizeof(CoreFrameBlock));
+        drawStride_ = AlignUp(CORE_MAX_INSTANCES * sizeof(CoreDrawBlock));   // Every draw binds a whole Draw block
+        particleOffset_ = AlignUp(drawOffset_ + CORE_MAX_DRAWS * drawStride_);
+        regionBytes_ = AlignUp(particleOffset_ + PARTICLE_CAPACITY * sizeof(ParticleVertex));
+
+        gl_.GenBuffers(1, &stream_);
+        gl_.BindBuffer(GL_ARRAY_BUFFER, stream_);
+        const GLsizeiptr total = (GLsizeiptr)(regionBytes_ * CORE_FRAMES_IN_FLIGHT);
+        const bool storage = allowPersistent && gl_.BufferStorage &&
+            (major * 10 + minor >= 44 || HasExtension("GL_ARB_buffer_storage"));
+        if (storage) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            gl_.BufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags);
+            mapped_ = (unsigned char*)gl_.MapBufferRange(GL_ARRAY_BUFFER, 0, total, flags);
+        }
+        if (!mapped_) {
+            // Without persistent mapping: stage on the CPU and upload each frame's region
+            if (storage) {      // Immutable storage cannot be respecified
+                gl_.DeleteBuffers(1, &stream_);
+                gl_.GenBuffers(1, &stream_);
+                gl_.BindBuffer(GL_ARRAY_BUFFER, stream_);
+            }
+            gl_.BufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW);
+            staging_.assign(regionBytes_, 0);
+        }
+
+        // Particles are drawn from the stream buffer; the region start is passed as the first vertex
+        gl_.GenVertexArrays(1, &particleVao_);
+        gl_.BindVertexArray(particleVao_);
+        gl_.EnableVertexAttribArray(0);
+        gl_.VertexAttribPointer(0, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ParticleVertex), (const void*)0);
+        gl_.EnableVertexAttribArray(1);
+        gl_.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleVertex), (const void*)offsetof(ParticleVertex, x));
+        gl_.BindVertexArray(0);
+
+        // Fixed state: every pass blends and depth-tests, only the depth mask changes
+        gl_.Enable(GL_DEPTH_TEST);
+        gl_.DepthFunc(GL_LESS);
+        gl_.Enable(GL_BLEND);
+        gl_.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl_.Enable(GL_PROGRAM_POINT_SIZE);
+
+        ready_ = true;
+        return true;
+    }
+
+    bool Ready() const { return ready_; }
+    bool Persistent() const { return mapped_ != nullptr; }
+    const char* Error() const { return error_; }
+    const CoreGL& GL() const { return gl_; }
+
+    // Draw one frame into the bound framebuffer (no present). Allocation-free once the meshes and
+    // grid are uploaded.
+    void Draw(const CoreScene& scene) {
+        if (!ready_ || scene.width <= 0 || scene.height <= 0) return;
+        const int lod = (scene.geometry == 1) ? 1 : 0;
+        EnsureSphere(lod);
+        if (scene.grid) EnsureGrid(scene.floorY);
+
+        // Claim this frame's region; with persistent mapping wait until the GPU is done with it
+        const int region = (int)(frame_ % CORE_FRAMES_IN_FLIGHT);
+        const size_t base = (size_t)region * regionBytes_;
+        unsigned char* out = mapped_ ? mapped_ + base : staging_.data();
+        if (mapped_ && fences_[region]) {
+            GLenum r = gl_.ClientWaitSync(fences_[region], 0, 0);
+            if (r == GL_TIMEOUT_EXPIRED) {
+                stats_.fenceWaits++;
+                do { r = gl_.ClientWaitSync(fences_[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull); }
+                while (r == GL_TIMEOUT_EXPIRED);
+            }
+            gl_.DeleteSync(fences_[region]);
+            fences_[region] = nullptr;
+        }
+
+        // Per-frame block
+        CoreFrameBlock fb;
+        ScenePerspective(fb.projection, (float)scene.width / (float)scene.height);
+        const float* l = SCENE_LIGHT_DIR;
+        const float ll = std::sqrt(l[0] * l[0] + l[1] * l[1] + l[2] * l[2]);
+        for (int k = 0; k < 4; ++k) {
+            fb.lightDir[k] = k < 3 ? l[k] / ll : 0.0f;
+            fb.ambient[k] = SCENE_MATERIAL_AMBIENT[k] * (SCENE_GLOBAL_AMBIENT[k] + SCENE_LIGHT_AMBIENT[k]);
+            fb.diffuse[k] = SCENE_MATERIAL_DIFFUSE[k] * SCENE_LIGHT_DIFFUSE[k];
+        }
+        fb.viewport[0] = (float)scene.width;
+        fb.viewport[1] = (float)scene.height;
+        fb.viewport[2] = SCENE_GRID_LINE_WIDTH;
+        fb.viewport[3] = SCENE_PARTICLE_POINT_SIZE;
+        std::memcpy(out, &fb, sizeof(fb));
+
+        // Draw blocks in drawing order: grid, floor shadows, wall shadows, balls, particles. The
+        // spheres in between are consecutive, so they become the instances of one draw.
+        drawCount_ = 0;
+        const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        float m[16];
+        if (scene.grid && gridIndexCount_) {
+            const float grid[4] = { SCENE_GRID_COLOR[0], SCENE_GRID_COLOR[1], SCENE_GRID_COLOR[2], 1.0f };
+            CameraMatrix(m, 0.0f);
+            AddDraw(out, DRAW_GRID, m, grid, CORE_SHADE_FLAT);
+        }
+        if (scene.floorShadow) {
+            const float shadow[4] = { 0.0f, 0.0f, 0.0f, SCENE_FLOOR_SHADOW_ALPHA };
+            for (size_t i = 0; i < scene.ballCount; ++i) {
+                SceneFloorShadowMatrix(m, scene.ballX[i], scene.ballFloorY[i], scene.ballZ[i]);
+                AddDraw(out, DRAW_MESH, m, shadow, CORE_SHADE_FLAT);
+            }
+        }
+        if (scene.wallShadow) {
+            const float shadow[4] = { 0.0f, 0.0f, 0.0f, SCENE_WALL_SHADOW_ALPHA };
+            for (size_t i = 0; i < scene.ballCount; ++i) {
+                SceneWallShadowMatrix(m, scene.ballX[i], scene.ballY[i]);
+                AddDraw(out, DRAW_MESH, m, shadow, CORE_SHADE_FLAT);
+            }
+        }
+        const float lit[4] = { 1.0f, 1.0f, 1.0f, SCENE_MATERIAL_DIFFUSE[3] };
+        for (size_t i = 0; i < scene.ballCount; ++i) {
+            SceneBallMatrix(m, scene.ballX[i], scene.ballY[i], scene.ballZ[i], scene.ballSpin[i]);
+            AddDraw(out, DRAW_MESH, m, scene.lighting ? lit : white,
+                scene.lighting ? CORE_SHADE_LIT_CHECKER : CORE_SHADE_CHECKER);
+        }
+        size_t particles = 0;
+        if (scene.particles && scene.particleCount) {
+            particles = scene.particleCount < PARTICLE_CAPACITY ? scene.particleCount : PARTICLE_CAPACITY;
+            std::memcpy(out + particleOffset_, scene.particles, particles * sizeof(ParticleVertex));
+            CameraMatrix(m, scene.particleOffsetX);
+            AddDraw(out, DRAW_PARTICLES, m, white, CORE_SHADE_FLAT);
+        }
+
+        const size_t used = particles ? particleOffset_ + particles * sizeof(ParticleVertex)
+                                      : drawOffset_ + drawCount_ * drawStride_;
+        gl_.BindBuffer(GL_ARRAY_BUFFER, stream_);
+        if (!mapped_) gl_.BufferSubData(GL_ARRAY_BUFFER, (GLintptr)base, (GLsizeiptr)used, out);
+        stats_.streamBytes += used;
+
+        // Issue the draws
+        gl_.Viewport(0, 0, scene.width, scene.height);
+        gl_.ClearColor(scene.clear[0], scene.clear[1], scene.clear[2], 1.0f);
+        gl_.DepthMask(GL_TRUE);
+        gl_.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        gl_.BindBufferRange(GL_UNIFORM_BUFFER, 0, stream_, (GLintptr)base, sizeof(CoreFrameBlock));
+
+        const SphereGpu& sphere = sphere_[lod];
+        GLuint program = 0;
+        for (size_t i = 0; i < drawCount_; ++i) {
+            const DrawKind kind = draws_[i];
+            const GLuint want = kind == DRAW_GRID ? gridProgram_ : (kind == DRAW_MESH ? meshProgram_ : particleProgram_);
+            if (want != program) {
+                gl_.UseProgram(want);
+                gl_.BindVertexArray(kind == DRAW_GRID ? gridVao_ : (kind == DRAW_MESH ? sphere.vao : particleVao_));
+                if (kind == DRAW_PARTICLES) gl_.DepthMask(GL_FALSE);    // Particles test depth but do not write it
+                program = want;
+            }
+            gl_.BindBufferRange(GL_UNIFORM_BUFFER, 1, stream_, (GLintptr)(base + drawOffset_ + i * drawStride_),
+                (GLsizeiptr)(CORE_MAX_INSTANCES * sizeof(CoreDrawBlock)));
+            if (kind == DRAW_GRID) gl_.DrawElements(GL_TRIANGLES, gridIndexCount_, GL_UNSIGNED_SHORT, nullptr);
+            else if (kind == DRAW_MESH) {
+                gl_.DrawElementsInstanced(GL_TRIANGLES, sphere.indexCount, GL_UNSIGNED_SHORT, nullptr, (GLsizei)instances_[i]);
+                stats_.instances += instances_[i];
+            }
+            else gl_.DrawArrays(GL_POINTS, (GLint)((base + particleOffset_) / sizeof(ParticleVertex)), (GLsizei)particles);
+        }
+        gl_.BindVertexArray(0);
+
+        if (mapped_) fences_[region] = gl_.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frame_++;
+        stats_.frames++;
+        stats_.draws += drawCount_;
+    }
+
+    // Counters since the last call
+    CoreStats TakeStats() {
+        CoreStats s = stats_;
+        stats_ = CoreStats();
+        return s;
+    }
+
+    // Buffer memory held on this context: the stream buffer plus whatever static buffers exist
+    size_t GpuBytes() const {
+        size_t bytes = stream_ ? regionBytes_ * CORE_FRAMES_IN_FLIGHT : 0;
+        for (const SphereGpu& s : sphere_) if (s.vao) bytes += SphereUploadBytes(assets_->sphere[&s - sphere_]);
+        bytes += (size_t)gridIndexCount_ / 6 * (4 * 7 * sizeof(float) + 6 * sizeof(uint16_t));
+        return bytes;
+    }
+
+    // Delete every GL object (the context must be current)
+    void Release() {
+        if (gl_.DeleteBuffers) {
+            for (GLsync& f : fences_) { if (f) gl_.DeleteSync(f); f = nullptr; }
+            if (mapped_) { gl_.BindBuffer(GL_ARRAY_BUFFER, stream_); gl_.UnmapBuffer(GL_ARRAY_BUFFER); }
+            for (SphereGpu& s : sphere_) {
+                if (s.vao) gl_.DeleteVertexArrays(1, &s.vao);
+                if (s.vbo) gl_.DeleteBuffers(1, &s.vbo);
+                if (s.ibo) gl_.DeleteBuffers(1, &s.ibo);
+            }
+            if (gridVao_) gl_.DeleteVertexArrays(1, &gridVao_);
+            if (particleVao_) gl_.DeleteVertexArrays(1, &particleVao_);
+            if (gridVbo_) gl_.DeleteBuffers(1, &gridVbo_);
+            if (gridIbo_) gl_.DeleteBuffers(1, &gridIbo_);
+            if (stream_) gl_.DeleteBuffers(1, &stream_);
+            if (meshProgram_) gl_.DeleteProgram(meshProgram_);
+            if (gridProgram_) gl_.DeleteProgram(gridProgram_);
+            if (particleProgram_) gl_.DeleteProgram(particleProgram_);
+        }
+        Forget();
+    }
+
+    // Drop every handle without deleting (the context and its objects are gone)
+    void Forget() {
+        for (SphereGpu& s : sphere_) s = SphereGpu();
+        for (GLsync& f : fences_) f = nullptr;
+        gridVao_ = gridVbo_ = gridIbo_ = particleVao_ = stream_ = 0;
+        meshProgram_ = gridProgram_ = particleProgram_ = 0;
+        gridIndexCount_ = 0;
+        mapped_ = nullptr;
+        ready_ = false;
+    }
+
+private:
+    enum DrawKind : uint8_t { DRAW_GRID, DRAW_MESH, DRAW_PARTICLES };
+
+    struct SphereGpu {
+        GLuint  vao = 0, vbo = 0, ibo = 0;
+        GLsizei indexCount = 0;
+    };
+
+    bool Fail(const char* why) {
+        std::snprintf(error_, sizeof(error_), "%s", why);
+        return false;
+    }
+
+    size_t AlignUp(size_t v) const { return (v + align_ - 1) / align_ * align_; }
+
+    bool HasExtension(const char* name) const {
+        GLint count = 0;
+        gl_.GetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* ext = (const char*)gl_.GetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (ext && std::strcmp(ext, name) == 0) return true;
+        }
+        return false;
+    }
+
+    GLuint CompileShader(GLenum type, const char* source) {
+        GLuint shader = gl_.CreateShader(type);
+        gl_.ShaderSource(shader, 1, &source, nullptr);
+        gl_.CompileShader(shader);
+        GLint ok = 0;
+        gl_.GetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            int len = std::snprintf(error_, sizeof(error_), "%s shader: ", type == GL_VERTEX_SHADER ? "vertex" : "fragment");
+            gl_.GetShaderInfoLog(shader, (GLsizei)(sizeof(error_) - (size_t)len), nullptr, error_ + len);
+            gl_.DeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    // Compile and link, then point the Frame and Draw blocks at bindings 0 and 1
+    GLuint BuildProgram(const char* vs, const char* fs) {
+        GLuint v = CompileShader(GL_VERTEX_SHADER, vs);
+        GLuint f = v ? CompileShader(GL_FRAGMENT_SHADER, fs) : 0;
+        if (!f) { if (v) gl_.DeleteShader(v); return 0; }
+        GLuint program = gl_.CreateProgram();
+        gl_.AttachShader(program, v);
+        gl_.AttachShader(program, f);
+        gl_.LinkProgram(program);
+        gl_.DeleteShader(v);
+        gl_.DeleteShader(f);
+        GLint ok = 0;
+        gl_.GetProgramiv(program, GL_LINK_STATUS, &ok);
+        if (!ok) {
+            int len = std::snprintf(error_, sizeof(error_), "link: ");
+            gl_.GetProgramInfoLog(program, (GLsizei)(sizeof(error_) - (size_t)len), nullptr, error_ + len);
+            gl_.DeleteProgram(program);
+            return 0;
+        }
+        const GLuint frame = gl_.GetUniformBlockIndex(program, "Frame");
+        const GLuint draw = gl_.GetUniformBlockIndex(program, "Draw");
+        if (frame != GL_INVALID_INDEX) gl_.UniformBlockBinding(program, frame, 0);
+        if (draw != GL_INVALID_INDEX) gl_.UniformBlockBinding(program, draw, 1);
+        return program;
+    }
+
+    static void CameraMatrix(float m[16], float worldOffsetX) {
+        for (int i = 0; i < 16; ++i) m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        m[12] = -worldOffsetX;
+        m[14] = -SCENE_CAMERA_Z;
+    }
+
+    // Append a draw, or another instance to the last draw when both are spheres
+    void AddDraw(unsigned char* out, DrawKind kind, const float m[16], const float color[4], CoreShade shade) {
+        const bool instance = kind == DRAW_MESH && drawCount_ && draws_[drawCount_ - 1] == DRAW_MESH &&
+            instances_[drawCount_ - 1] < CORE_MAX_INSTANCES;
+        if (!instance) {
+            if (drawCount_ == CORE_MAX_DRAWS) return;
+            draws_[drawCount_] = kind;
+            instances_[drawCount_] = 0;
+            ++drawCount_;
+        }
+        const size_t i = drawCount_ - 1;
+        CoreDrawBlock db;
+        std::memcpy(db.modelview, m, sizeof(db.modelview));
+        std::memcpy(db.color, color, sizeof(db.color));
+        db.shade[0] = (float)shade;
+        db.shade[1] = db.shade[2] = db.shade[3] = 0.0f;
+        std::memcpy(out + drawOffset_ + i * drawStride_ + instances_[i] * sizeof(CoreDrawBlock), &db, sizeof(db));
+        instances_[i]++;
+    }
+
+    // Upload a sphere LOD from the shared assets on first use: positions, normals and texcoords
+    // back to back in one buffer
+    void EnsureSphere(int lod) {
+        SphereGpu& s = sphere_[lod];
+        if (s.vao) return;
+        const SphereMeshView& mesh = assets_->sphere[lod];
+        const size_t pos = (size_t)mesh.vertexCount * 3 * sizeof(float);
+        const size_t tex = (size_t)mesh.vertexCount * 2 * sizeof(float);
+        gl_.GenVertexArrays(1, &s.vao);
+        gl_.BindVertexArray(s.vao);
+        gl_.GenBuffers(1, &s.vbo);
+        gl_.BindBuffer(GL_ARRAY_BUFFER, s.vbo);
+        gl_.BufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(2 * pos + tex), nullptr, GL_STATIC_DRAW);
+        gl_.BufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)pos, mesh.positions);
+        gl_.BufferSubData(GL_ARRAY_BUFFER, (GLintptr)pos, (GLsizeiptr)pos, mesh.normals);
+        gl_.BufferSubData(GL_ARRAY_BUFFER, (GLintptr)(2 * pos), (GLsizeiptr)tex, mesh.texcoords);
+        gl_.EnableVertexAttribArray(0);
+        gl_.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (const void*)0);
+        gl_.EnableVertexAttribArray(1);
+        gl_.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, (const void*)pos);
+        gl_.EnableVertexAttribArray(2);
+        gl_.VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, (const void*)(2 * pos));
+        gl_.GenBuffers(1, &s.ibo);
+        gl_.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, s.ibo);
+        gl_.BufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(mesh.indexCount * sizeof(uint16_t)), mesh.indices, GL_STATIC_DRAW);
+        gl_.BindVertexArray(0);
+        s.indexCount = (GLsizei)mesh.indexCount;
+        stats_.uploads++;
+    }
+
+    // (Re)build the grid quads for a floor height: four corners per line, each with its own end,
+    // the other end and the side it spreads to
+    void EnsureGrid(float floorY) {
+        if (gridVao_ && gridFloorY_ == floorY) return;
+        float vertices[CORE_MAX_GRID_LINES * 4 * 7];
+        uint16_t indices[CORE_MAX_GRID_LINES * 6];
+        size_t lines = 0;
+        ForEachGridLine(floorY, [&](float x0, float y0, float z0, float x1, float y1, float z1) {
+            if (lines == CORE_MAX_GRID_LINES) return;
+            const float a[3] = { x0, y0, z0 }, b[3] = { x1, y1, z1 };
+            for (int c = 0; c < 4; ++c) {
+                float* v = vertices + (lines * 4 + c) * 7;
+                const float* self = c < 2 ? a : b;
+                const float* other = c < 2 ? b : a;
+                for (int k = 0; k < 3; ++k) { v[k] = self[k]; v[3 + k] = other[k]; }
+                v[6] = (c & 1) ? 1.0f : -1.0f;
+            }
+            const uint16_t q = (uint16_t)(lines * 4);
+            const uint16_t tri[6] = { q, (uint16_t)(q + 1), (uint16_t)(q + 2), (uint16_t)(q + 2), (uint16_t)(q + 1), (uint16_t)(q + 3) };
+            std::memcpy(indices + lines * 6, tri, sizeof(tri));
+            ++lines;
+        });
+
+        if (!gridVao_) {
+            gl_.GenVertexArrays(1, &gridVao_);
+            gl_.GenBuffers(1, &gridVbo_);
+            gl_.GenBuffers(1, &gridIbo_);
+        }
+        gl_.BindVertexArray(gridVao_);
+        gl_.BindBuffer(GL_ARRAY_BUFFER, gridVbo_);
+        gl_.BufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(lines * 4 * 7 * sizeof(float)), vertices, GL_STATIC_DRAW);
+        const GLsizei stride = 7 * sizeof(float);
+        gl_.EnableVertexAttribArray(0);
+        gl_.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (const void*)0);
+        gl_.EnableVertexAttribArray(1);
+        gl_.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(3 * sizeof(float)));
+        gl_.EnableVertexAttribArray(2);
+        gl_.VertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (const void*)(6 * sizeof(float)));
+        gl_.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridIbo_);
+        gl_.BufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(lines * 6 * sizeof(uint16_t)), indices, GL_STATIC_DRAW);
+        gl_.BindVertexArray(0);
+        gridIndexCount_ = (GLsizei)(lines * 6);
+        gridFloorY_ = floorY;
+        stats_.uploads++;
+    }
+
+    CoreGL              gl_;
+    const SharedAssets* assets_ = nullptr;
+    bool                ready_ = false;
+    char                error_[512] = {};
+
+    GLuint    meshProgram_ = 0, gridProgram_ = 0, particleProgram_ = 0;
+    SphereGpu sphere_[2];
+    GLuint    gridVao_ = 0, gridVbo_ = 0, gridIbo_ = 0;
+    GLsizei   gridIndexCount_ = 0;
+    float     gridFloorY_ = 0.0f;
+    GLuint    particleVao_ = 0;
+
+    // Stream buffer: CORE_FRAMES_IN_FLIGHT regions of regionBytes_, persistently mapped when possible
+    GLuint                     stream_ = 0;
+    unsigned char*             mapped_ = nullptr;
+    std::vector<unsigned char> staging_;      // One region, when not mapped
+    GLsync                     fences_[CORE_FRAMES_IN_FLIGHT] = {};
+    size_t   align_ = 256, drawOffset_ = 0, drawStride_ = 0, particleOffset_ = 0, regionBytes_ = 0;
+    uint64_t frame_ = 0;
+
+    DrawKind  draws_[CORE_MAX_DRAWS] = {};
+    size_t    instances_[CORE_MAX_DRAWS] = {};   // Draw blocks written for each draw
+    size_t    drawCount_ = 0;
+    CoreStats stats_;
+};
@@ -0,0 +1,214 @@
+// BoingExport.h — frame export ring: finished frames in a named shared-memory block for capture and
+// signage tools on the same machine
+// Portable (no Windows headers): the saver maps the block with CreateFileMapping, the sample
+// consumer in tools/BoingFrameExport.cpp with shm_open; both lay it out through these types.
+// Layout: one ExportRingHeader, then slotCount slots of slotStride bytes, each an ExportSlotHeader
+// followed by the pixels (64-byte aligned). The producer fills slots round robin and never waits.
+// Every slot is a seqlock: its sequence is odd while the producer writes it and moves on by two
+// per publish, so a consumer reads the pixels in place (no copy) and then checks that the
+// sequence did not move underneath it; if it did, the frame was overwritten and is dropped.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+const uint32_t EXPORT_MAGIC = 0x58464242;    // "BBFX"
+const uint32_t EXPORT_VERSION = 1;
+const uint32_t EXPORT_MIN_SLOTS = 2;
+const uint32_t EXPORT_MAX_SLOTS = 8;
+const uint32_t EXPORT_DEFAULT_SLOTS = 3;
+const size_t   EXPORT_ALIGN = 64;
+
+// Mapping name, followed by the output number: "Local\BoingBallSaverFrames0" on Windows,
+// "/BoingBallSaverFrames0" for POSIX shared memory
+const char EXPORT_RING_NAME[] = "BoingBallSaverFrames";
+
+enum ExportPixelFormat : uint32_t {
+    EXPORT_FORMAT_BGRA8 = 1,     // Bytes B, G, R, A (what GDI and most capture APIs want)
+    EXPORT_FORMAT_RGBA8 = 2
+};
+
+const uint32_t EXPORT_FLAG_BOTTOM_UP = 1;    // First row in memory is the bottom of the image (GL readback)
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the export ring needs address-free 64-bit atomics");
+
+struct alignas(EXPORT_ALIGN) ExportRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t producerPid;
+    uint64_t slotStride;                 // Bytes from one slot header to the next
+    uint64_t pixelCapacity;              // Pixel bytes a slot can hold
+    std::atomic<uint64_t> latest;        // Number of the newest published frame (0 = none yet)
+};
+
+// Written by the producer while the sequence is odd; consumers load the fields relaxed and trust
+// them only if the sequence is unchanged afterwards
+struct alignas(EXPORT_ALIGN) ExportSlotHeader {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> frame;         // Frame number, counting from 1 (0 = cancelled)
+    std::atomic<uint64_t> captureNs;     // When the frame's scene state was sampled
+    std::atomic<uint64_t> publishNs;     // When its pixels were complete
+    std::atomic<uint32_t> width, height;
+    std::atomic<uint32_t> stride;        // Bytes per row
+    std::atomic<uint32_t> format;        // ExportPixelFormat
+    std::atomic<uint32_t> flags;         // EXPORT_FLAG_*
+};
+
+// Timestamps are the producer's monotonic clock in nanoseconds (QueryPerformanceCounter on
+// Windows, CLOCK_MONOTONIC on POSIX), so consumers on the same machine can measure latency
+
+inline uint64_t ExportSlotStride(uint64_t pixelCapacity) {
+    return sizeof(ExportSlotHeader) + ((pixelCapacity + EXPORT_ALIGN - 1) & ~(uint64_t)(EXPORT_ALIGN - 1));
+}
+
+inline uint64_t ExportRingBytes(uint32_t slotCount, uint64_t pixelCapacity) {
+    return sizeof(ExportRingHeader) + (uint64_t)slotCount * ExportSlotStride(pixelCapacity);
+}
+
+class ExportRingWriter {
+public:
+    // Lay the ring out over a fresh mapping of ExportRingBytes(slotCount, pixelCapacity) bytes
+    bool Attach(void* base, uint64_t bytes, uint32_t slotCount, uint64_t pixelCapacity, uint32_t pid) {
+        base_ = nullptr;
+        if (!base || slotCount < EXPORT_MIN_SLOTS || slotCount > EXPORT_MAX_SLOTS) return false;
+        if (bytes < ExportRingBytes(slotCount, pixelCapacity)) return false;
+        ExportRingHeader* h = new (base) ExportRingHeader();
+        h->magic = EXPORT_MAGIC;
+        h->version = EXPORT_VERSION;
+        h->slotCount = slotCount;
+        h->producerPid = pid;
+        h->slotStride = ExportSlotStride(pixelCapacity);
+        h->pixelCapacity = pixelCapacity;
+        h->latest.store(0, std::memory_order_relaxed);
+        base_ = (unsigned char*)base;
+        for (uint32_t i = 0; i < slotCount; ++i) new (Slot(i)) ExportSlotHeader();
+        frame_ = 0;
+        writing_ = nullptr;
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    bool     IsAttached() const { return base_ != nullptr; }
+    void*    Base() const { return base_; }
+    uint64_t PixelCapacity() const { return base_ ? Header()->pixelCapacity : 0; }
+    uint64_t Frames() const { return frame_; }
+
+    // Claim the next slot and return where its pixels go, or nullptr when the image does not fit
+    unsigned char* BeginFrame(uint32_t width, uint32_t height, uint32_t stride, uint32_t format, uint32_t flags,
+        uint64_t captureNs) {
+        if (!base_ || writing_ || (uint64_t)stride * height > Header()->pixelCapacity) return nullptr;
+        const uint64_t number = frame_ + 1;
+        ExportSlotHeader* s = Slot((uint32_t)((number - 1) % Header()->slotCount));
+        s->seq.store(s->seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);    // Odd before any field or pixel changes
+        s->frame.store(number, std::memory_order_relaxed);
+        s->captureNs.store(captureNs, std::memory_order_relaxed);
+        s->width.store(width, std::memory_order_relaxed);
+        s->height.store(height, std::memory_order_relaxed);
+        s->stride.store(stride, std::memory_order_relaxed);
+        s->format.store(format, std::memory_order_relaxed);
+        s->flags.store(flags, std::memory_order_relaxed);
+        writing_ = s;
+        return (unsigned char*)(s + 1);
+    }
+
+    // Make the claimed slot the newest frame
+    void Publish(uint64_t publishNs) {
+        if (!writing_) return;
+        writing_->publishNs.store(publishNs, std::memory_order_relaxed);
+        writing_->seq.store(writing_->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        Header()->latest.store(++frame_, std::memory_order_release);
+        writing_ = nullptr;
+    }
+
+    // Give the claimed slot up (readback failed): it stays stable but holds no frame
+    void Cancel() {
+        if (!writing_) return;
+        writing_->frame.store(0, std::memory_order_relaxed);
+        writing_->seq.store(writing_->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        writing_ = nullptr;
+    }
+
+    void Detach() { base_ = nullptr; writing_ = nullptr; }
+
+private:
+    ExportRingHeader* Header() const { return (ExportRingHeader*)base_; }
+    ExportSlotHeader* Slot(uint32_t i) const {
+        return (ExportSlotHeader*)(base_ + sizeof(ExportRingHeader) + (uint64_t)i * Header()->slotStride);
+    }
+
+    unsigned char*    base_ = nullptr;
+    ExportSlotHeader* writing_ = nullptr;
+    uint64_t          frame_ = 0;
+};
+
+// A frame as seen by a consumer: pixels point straight into the mapping
+struct ExportFrameView {
+    uint64_t frame = 0;
+    uint64_t captureNs = 0, publishNs = 0;
+    uint32_t width = 0, height = 0, stride = 0, format = 0, flags = 0;
+    const unsigned char* pixels = nullptr;
+    const ExportSlotHeader* slot = nullptr;
+    uint64_t seq = 0;
+};
+
+class ExportRingReader {
+public:
+    bool Attach(const void* base, uint64_t bytes) {
+        base_ = nullptr;
+        const ExportRingHeader* h = (const ExportRingHeader*)base;
+        if (!h || bytes < sizeof(ExportRingHeader)) return false;
+        if (h->magic != EXPORT_MAGIC || h->version != EXPORT_VERSION) return false;
+        if (h->slotCount < EXPORT_MIN_SLOTS || h->slotCount > EXPORT_MAX_SLOTS) return false;
+        if (h->slotStride != ExportSlotStride(h->pixelCapacity)) return false;
+        if (bytes < ExportRingBytes(h->slotCount, h->pixelCapacity)) return false;
+        base_ = (const unsigned char*)base;
+        return true;
+    }
+
+    bool IsAttached() const { return base_ != nullptr; }
+    uint32_t ProducerPid() const { return Header()->producerPid; }
+    uint64_t Latest() const { return Header()->latest.load(std::memory_order_acquire); }
+
+    // The newest frame if it is newer than after. False when there is none, or the producer is
+    // already rewriting its slot (it lapped the ring; try again).
+    bool Acquire(uint64_t after, ExportFrameView& view) const {
+        const uint64_t number = Latest();
+        if (number <= after) return false;
+        const ExportSlotHeader* s = Slot((uint32_t)((number - 1) % Header()->slotCount));
+        const uint64_t seq = s->seq.load(std::memory_order_acquire);
+        if (seq & 1) return false;
+        view.frame = s->frame.load(std::memory_order_relaxed);
+        view.captureNs = s->captureNs.load(std::memory_order_relaxed);
+        view.publishNs = s->publishNs.load(std::memory_order_relaxed);
+        view.width = s->width.load(std::memory_order_relaxed);
+        view.height = s->height.load(std::memory_order_relaxed);
+        view.stride = s->stride.load(std::memory_order_relaxed);
+        view.format = s->format.load(std::memory_order_relaxed);
+        view.flags = s->flags.load(std::memory_order_relaxed);
+        view.pixels = (const unsigned char*)(s + 1);
+        view.slot = s;
+        view.seq = seq;
+        if (view.frame != number || (uint64_t)view.stride * view.height > Header()->pixelCapacity) return false;
+        return StillValid(view);
+    }
+
+    // True while the producer has not started rewriting the frame's slot; check after using the
+    // pixels and discard whatever was derived from them if it fails
+    bool StillValid(const ExportFrameView& view) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return view.slot && view.slot->seq.load(std::memory_order_relaxed) == view.seq;
+    }
+
+private:
+    const ExportRingHeader* Header() const { return (const ExportRingHeader*)base_; }
+    const ExportSlotHeader* Slot(uint32_t i) const {
+        return (const ExportSlotHeader*)(base_ + sizeof(ExportRingHeader) + (uint64_t)i * Header()->slotStride);
+    }
+
+    const unsigned char* base_ = nullptr;
+};
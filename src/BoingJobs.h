@@ -0,0 +1,356 @@
+// BoingJobs.h — work-stealing job system shared by simulation, rendering and asset preparation
+// Portable (standard threads only, no Windows headers). One thread per core by default, the caller
+// of Start() counting as thread 0, with an optional cap for shared hosts. Every thread owns a
+// fixed-size deque: it pushes and pops its own jobs at the bottom (newest first, still in cache),
+// idle threads steal from the top of the others (oldest first, the biggest pieces of work).
+// Jobs form a graph two ways: children keep their parent unfinished until they all complete
+// (fork/join), and continuations are queued when their predecessor finishes. Wait() never just
+// blocks: the waiting thread runs jobs until the one it waits for is done.
+// Job storage is a fixed ring per thread and job payloads are copied inline, so submitting work
+// never touches the heap once Start() has returned.
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+const size_t JOB_MAX_THREADS = 64;
+const size_t JOB_QUEUE_SIZE = 1024;       // Per thread, power of two; a full queue runs the job inline
+const size_t JOB_RING_SIZE = 1024;        // Jobs a thread can have in flight, power of two; Create helps when full
+const int    JOB_RING_STALL_MS = 2000;    // A full ring with nothing to run for this long is a bug
+const size_t JOB_PAYLOAD_SIZE = 64;
+const size_t JOB_MAX_PIECES = 256;        // ParallelFor raises the grain to stay under this
+const int    JOB_MAX_CONTINUATIONS = 4;
+
+struct Job;
+typedef void (*JobFunction)(Job* job, const void* payload);
+
+struct alignas(64) Job {
+    JobFunction          fn = nullptr;
+    Job*                 parent = nullptr;
+    std::atomic<int32_t> unfinished{ 0 };      // Itself plus children not yet done
+    int32_t              continuationCount = 0;
+    Job*                 continuations[JOB_MAX_CONTINUATIONS] = {};
+    alignas(16) unsigned char payload[JOB_PAYLOAD_SIZE];
+};
+
+// Per-thread counters (thread 0 is the one that called Start)
+struct JobThreadStats {
+    uint64_t jobs = 0;
+    uint64_t steals = 0;
+    uint64_t busyNs = 0;       // Time spent inside job functions
+};
+
+// Fixed-capacity Chase-Lev deque (Le et al., "Correct and efficient work-stealing for weak memory
+// models", without the resize). Push and Pop are owner-only; Steal may be called from any thread.
+class JobDeque {
+public:
+    bool Push(Job* job) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t >= (int64_t)JOB_QUEUE_SIZE) return false;
+        items_[b & (JOB_QUEUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* Pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job* job = items_[b & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last item: race the thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* Steal() {
+        int64_t t = top_.load(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+        Job* job = items_[t & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top_{ 0 };
+    alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    std::atomic<Job*> items_[JOB_QUEUE_SIZE] = {};
+};
+
+class JobSystem {
+public:
+    ~JobSystem() { Stop(); }
+
+    // Start the pool: one thread per core, at most maxThreads when that is non-zero (the calling
+    // thread counts as one, so 1 means no workers and every job runs inside Wait). Stress tests
+    // pass their own core count to oversubscribe.
+    void Start(unsigned maxThreads = 0, unsigned cores = std::thread::hardware_concurrency()) {
+        if (threadCount_) return;
+        unsigned threads = cores ? cores : 1;
+        if (maxThreads && maxThreads < threads) threads = maxThreads;
+        if (threads > JOB_MAX_THREADS) threads = (unsigned)JOB_MAX_THREADS;
+
+        threadCount_ = threads;
+        stop_ = false;
+        states_ = new ThreadState[threads];
+        ThreadIndex() = 0;
+        Self() = this;
+        for (unsigned i = 1; i < threads; ++i) states_[i].thread = std::thread(&JobSystem::WorkerMain, this, i);
+    }
+
+    // Join the workers; every job must have been waited for
+    void Stop() {
+        if (!threadCount_) return;
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (unsigned i = 1; i < threadCount_; ++i) states_[i].thread.join();
+        delete[] states_;
+        states_ = nullptr;
+        threadCount_ = 0;
+    }
+
+    unsigned ThreadCount() const { return threadCount_; }
+
+    // Make a job from a raw function and payload (copied). With a parent, the parent stays
+    // unfinished until this job completes: create children from inside the parent or before running it.
+    Job* Create(JobFunction fn, const void* payload = nullptr, size_t size = 0, Job* parent = nullptr) {
+        ThreadState& ts = states_[ThreadIndex()];
+        Job* job = Claim(ts);
+        job->fn = fn;
+        job->parent = parent;
+        job->continuationCount = 0;
+        job->unfinished.store(1, std::memory_order_relaxed);
+        if (size) std::memcpy(job->payload, payload, size);
+        if (parent) parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    // Make a job from a callable taking (Job*); it is copied into the job, so captures must be
+    // small and trivially copyable (pointers and references)
+    template <typename F>
+    Job* Create(const F& f, Job* parent = nullptr) {
+        static_assert(sizeof(F) <= JOB_PAYLOAD_SIZE, "job callable too large for the inline payload");
+        static_assert(std::is_trivially_copyable<F>::value, "job callable must be trivially copyable");
+        return Create([](Job* job, const void* payload) { (*(const F*)payload)(job); }, &f, sizeof(F), parent);
+    }
+
+    // Queue next to run once job (and its children) finish; add before job is run
+    bool AddContinuation(Job* job, Job* next) {
+        if (job->continuationCount == JOB_MAX_CONTINUATIONS) return false;
+        job->continuations[job->continuationCount++] = next;
+        return true;
+    }
+
+    void Run(Job* job) {
+        ThreadState& ts = states_[ThreadIndex()];
+        if (!ts.queue.Push(job)) { Execute(ts, job); return; }
+        queued_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wake_.notify_one();
+        }
+    }
+
+    bool IsDone(const Job* job) const { return job->unfinished.load(std::memory_order_acquire) == 0; }
+
+    // Run other jobs until job is finished
+    void Wait(const Job* job) {
+        ThreadState& ts = states_[ThreadIndex()];
+        while (!IsDone(job)) {
+            if (Job* next = Find(ts)) Execute(ts, next);
+            else std::this_thread::yield();
+        }
+    }
+
+    // Call fn(begin, end) over [0, count) in pieces of at most grain items, on every thread, and
+    // return when all are done. The range is split in halves so thieves take large pieces.
+    template <typename F>
+    void ParallelFor(size_t count, size_t grain, const F& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (count / grain > JOB_MAX_PIECES) grain = (count + JOB_MAX_PIECES - 1) / JOB_MAX_PIECES;
+        RangeJob range = { [](size_t begin, size_t end, const void* ctx) { (*(const F*)ctx)(begin, end); }, &fn, 0, count, grain };
+        Job* root = Create(&JobSystem::SplitRange, &range, sizeof(range));
+        Run(root);
+        Wait(root);
+    }
+
+    // Call fn(x0, y0, x1, y1) for every tile of a width x height image, tiles in parallel
+    template <typename F>
+    void ParallelForTiles(int width, int height, int tileSize, const F& fn) {
+        if (width <= 0 || height <= 0 || tileSize <= 0) return;
+        const int tilesX = (width + tileSize - 1) / tileSize;
+        const int tilesY = (height + tileSize - 1) / tileSize;
+        ParallelFor((size_t)tilesX * (size_t)tilesY, 1, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t) {
+                int x0 = (int)(t % (size_t)tilesX) * tileSize, y0 = (int)(t / (size_t)tilesX) * tileSize;
+                int x1 = x0 + tileSize < width ? x0 + tileSize : width;
+                int y1 = y0 + tileSize < height ? y0 + tileSize : height;
+                fn(x0, y0, x1, y1);
+            }
+        });
+    }
+
+    // Counters since the last call, per thread (safe to read while the pool is idle between frames)
+    JobThreadStats TakeStats(unsigned thread) {
+        ThreadState& ts = states_[thread];
+        JobThreadStats s;
+        s.jobs = ts.jobs.exchange(0, std::memory_order_relaxed);
+        s.steals = ts.steals.exchange(0, std::memory_order_relaxed);
+        s.busyNs = ts.busyNs.exchange(0, std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct alignas(64) ThreadState {
+        JobDeque              queue;
+        Job                   ring[JOB_RING_SIZE];
+        uint32_t              next = 0;             // Ring cursor (owner only)
+        uint32_t              victim = 0;           // Where stealing starts next (owner only)
+        std::atomic<uint64_t> jobs{ 0 };
+        std::atomic<uint64_t> steals{ 0 };
+        std::atomic<uint64_t> busyNs{ 0 };
+        std::thread           thread;
+    };
+
+    // Next ring slot whose job is done. With every slot in flight (a wide fan-out from one thread)
+    // run queued jobs until one frees up, as Wait does. Only a ring full of jobs that were created
+    // but never run cannot drain; debug builds stop on that instead of spinning.
+    Job* Claim(ThreadState& ts) {
+        auto stalledSince = std::chrono::steady_clock::now();
+        for (;;) {
+            for (size_t n = 0; n < JOB_RING_SIZE; ++n) {
+                Job* job = &ts.ring[ts.next++ & (JOB_RING_SIZE - 1)];
+                if (IsDone(job)) return job;
+            }
+            if (Job* next = Find(ts)) {
+                Execute(ts, next);
+                stalledSince = std::chrono::steady_clock::now();
+                continue;
+            }
+            assert(std::chrono::steady_clock::now() - stalledSince < std::chrono::milliseconds(JOB_RING_STALL_MS) &&
+                "JobSystem: job ring full of jobs that were created but never run");
+            std::this_thread::yield();
+        }
+    }
+
+    typedef void (*RangeFunction)(size_t begin, size_t end, const void* ctx);
+    struct RangeJob {
+        RangeFunction fn;
+        const void*   ctx;
+        size_t        begin, end, grain;
+    };
+
+    // Split until a piece fits the grain: the right half goes to the queue, the left half is kept
+    static void SplitRange(Job* job, const void* payload) {
+        RangeJob r = *(const RangeJob*)payload;
+        JobSystem& js = *Self();
+        while (r.end - r.begin > r.grain) {
+            RangeJob right = r;
+            right.begin = r.begin + (r.end - r.begin) / 2;
+            r.end = right.begin;
+            js.Run(js.Create(&JobSystem::SplitRange, &right, sizeof(right), job));
+        }
+        r.fn(r.begin, r.end, r.ctx);
+    }
+
+    static unsigned& ThreadIndex() {
+        static thread_local unsigned index = 0;
+        return index;
+    }
+
+    // The system a job is running on (one pool per process)
+    static JobSystem*& Self() {
+        static JobSystem* self = nullptr;
+        return self;
+    }
+
+    Job* Find(ThreadState& ts) {
+        if (Job* job = ts.queue.Pop()) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+        const unsigned self = ThreadIndex();
+        for (unsigned n = 0; n < threadCount_; ++n) {
+            unsigned victim = (ts.victim + n) % threadCount_;
+            if (victim == self) continue;
+            if (Job* job = states_[victim].queue.Steal()) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                ts.victim = victim;     // Come back to this one first
+                ts.steals.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void Execute(ThreadState& ts, Job* job) {
+        auto t0 = std::chrono::steady_clock::now();
+        job->fn(job, job->payload);
+        auto t1 = std::chrono::steady_clock::now();
+        ts.busyNs.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(), std::memory_order_relaxed);
+        ts.jobs.fetch_add(1, std::memory_order_relaxed);
+        Finish(job);
+    }
+
+    // Read the links before the last decrement: once it lands, a waiter may move on
+    void Finish(Job* job) {
+        Job* parent = job->parent;
+        Job* next[JOB_MAX_CONTINUATIONS];
+        const int count = job->continuationCount;
+        for (int i = 0; i < count; ++i) next[i] = job->continuations[i];
+        if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        for (int i = 0; i < count; ++i) Run(next[i]);
+        if (parent) Finish(parent);
+    }
+
+    void WorkerMain(unsigned index) {
+        ThreadIndex() = index;
+        ThreadState& ts = states_[index];
+        unsigned idleSpins = 0;
+        for (;;) {
+            if (Job* job = Find(ts)) {
+                Execute(ts, job);
+                idleSpins = 0;
+                continue;
+            }
+            if (++idleSpins < 64) { std::this_thread::yield(); continue; }
+
+            // Nothing queued anywhere: sleep until Run() or Stop()
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            wake_.wait(lock, [this]() { return stop_ || queued_.load(std::memory_order_seq_cst) > 0; });
+            sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+            if (stop_) return;
+            idleSpins = 0;
+        }
+    }
+
+    ThreadState*            states_ = nullptr;
+    unsigned                threadCount_ = 0;
+    std::atomic<int64_t>    queued_{ 0 };           // Jobs sitting in any queue
+    std::atomic<int>        sleeping_{ 0 };
+    std::mutex              sleepMutex_;
+    std::condition_variable wake_;
+    bool                    stop_ = false;
+};
@@ -0,0 +1,78 @@
+// BoingMemory.h — allocation-free containers for the render loop: a per-frame bump arena and a
+// fixed-capacity vector for long-lived objects such as the output list
+// Portable (no Windows headers). None of these touch the heap after construction.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Bump allocator over caller-provided storage, reset once per frame
+// Allocations live until the next Reset(); a full arena returns nullptr (counted as an overflow).
+class FrameArena {
+public:
+    FrameArena(void* storage, size_t capacity) : base_((unsigned char*)storage), capacity_(capacity) {}
+
+    void* Alloc(size_t size, size_t align = 16) {
+        size_t start = (used_ + align - 1) & ~(align - 1);
+        if (start + size > capacity_) { ++overflows_; return nullptr; }
+        used_ = start + size;
+        if (used_ > peak_) peak_ = used_;
+        return base_ + start;
+    }
+
+    template <typename T>
+    T* AllocArray(size_t count) { return (T*)Alloc(sizeof(T) * count, alignof(T) > 16 ? alignof(T) : 16); }
+
+    void   Reset() { used_ = 0; }
+    size_t Used() const { return used_; }
+    size_t Capacity() const { return capacity_; }
+    size_t Peak() const { return peak_; }            // High-water mark since the last ResetStats()
+    size_t Overflows() const { return overflows_; }
+    void   ResetStats() { peak_ = used_; overflows_ = 0; }
+
+private:
+    unsigned char* base_;
+    size_t capacity_;
+    size_t used_ = 0;
+    size_t peak_ = 0;
+    size_t overflows_ = 0;
+};
+
+// Vector-like array with fixed capacity: no reallocation, so push_back never moves an element.
+// erase keeps the order and moves every later element down one slot: pointers to them then point
+// at their successors.
+template <typename T, size_t N>
+class FixedVector {
+public:
+    bool push_back(const T& v) {
+        if (size_ == N) return false;
+        items_[size_++] = v;
+        return true;
+    }
+    void pop_back() { if (size_) items_[--size_] = T(); }
+    T* erase(T* it) {
+        T* last = items_ + size_ - 1;
+        for (T* p = it; p < last; ++p) *p = std::move(*(p + 1));
+        pop_back();
+        return it;
+    }
+    void clear() { while (size_) pop_back(); }
+
+    T*       begin() { return items_; }
+    T*       end() { return items_ + size_; }
+    const T* begin() const { return items_; }
+    const T* end() const { return items_ + size_; }
+    T&       back() { return items_[size_ - 1]; }
+    T&       operator[](size_t i) { return items_[i]; }
+    const T& operator[](size_t i) const { return items_[i]; }
+    size_t   size() const { return size_; }
+    bool     empty() const { return size_ == 0; }
+    bool     full() const { return size_ == N; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T      items_[N];
+    size_t size_ = 0;
+};
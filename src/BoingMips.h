@@ -0,0 +1,138 @@
+// BoingMips.h — mip chain generation for RGB8/RGBA8 textures (2x2 box filter, SSE2 where available)
+// Portable (no Windows or GL headers). All levels live back to back in one preallocated buffer so
+// they can be uploaded level by level with glTexImage2D (GL_UNPACK_ALIGNMENT 1).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOING_MIPS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+const int MIP_MAX_LEVELS = 16;   // Enough for a 32768 pixel base level
+
+struct TextureMip {
+    int    width = 0, height = 0;
+    size_t offset = 0;              // Byte offset of this level in the texel block
+};
+
+// Level sizes and offsets for a w x h base level down to 1x1; returns the total byte count
+inline size_t MipChainLayout(int w, int h, int channels, TextureMip* mips, int& levels) {
+    size_t total = 0;
+    levels = 0;
+    for (; levels < MIP_MAX_LEVELS; w = (w > 1) ? w / 2 : 1, h = (h > 1) ? h / 2 : 1) {
+        mips[levels].width = w;
+        mips[levels].height = h;
+        mips[levels].offset = total;
+        ++levels;
+        total += (size_t)w * (size_t)h * (size_t)channels;
+        if (w == 1 && h == 1) break;
+    }
+    return total;
+}
+
+// Reference 2x2 box filter (odd edges clamp); also the path for 1-pixel-wide or tall levels
+inline void DownsampleBoxScalar(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh, int channels) {
+    for (int y = 0; y < dh; ++y) {
+        int y0 = (2 * y < sh) ? 2 * y : sh - 1;
+        int y1 = (2 * y + 1 < sh) ? 2 * y + 1 : y0;
+        for (int x = 0; x < dw; ++x) {
+            int x0 = (2 * x < sw) ? 2 * x : sw - 1;
+            int x1 = (2 * x + 1 < sw) ? 2 * x + 1 : x0;
+            for (int c = 0; c < channels; ++c) {
+                int sum = src[(y0 * sw + x0) * channels + c] + src[(y0 * sw + x1) * channels + c] +
+                    src[(y1 * sw + x0) * channels + c] + src[(y1 * sw + x1) * channels + c];
+                dst[(y * dw + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+#if BOING_MIPS_SSE2
+// One output row from two source rows (exact halving), 16-bit sums, same rounding as the scalar filter
+inline void DownsampleRowSSE2(const unsigned char* r0, const unsigned char* r1, unsigned char* out, int dw, int channels) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    const int rowBytes = 2 * dw * channels;
+    int x = 0;
+
+    if (channels == 4) {
+        // 4 source pixels -> 2 output pixels per step
+        for (; 8 * x + 16 <= rowBytes; x += 2) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(r0 + 8 * x));
+            __m128i b = _mm_loadu_si128((const __m128i*)(r1 + 8 * x));
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));   // Pixels 0, 1
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));   // Pixels 2, 3
+            lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+            hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+            __m128i sum = _mm_unpacklo_epi64(lo, hi);
+            __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+            _mm_storel_epi64((__m128i*)(out + 4 * x), _mm_packus_epi16(avg, zero));
+        }
+    }
+    else if (channels == 3) {
+        // 4 source pixels (12 bytes, 16 loaded) -> 2 output pixels per step
+        const __m128i keep3 = _mm_setr_epi16(-1, -1, -1, 0, 0, 0, 0, 0);
+        for (; 6 * x + 16 <= rowBytes; x += 2) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(r0 + 6 * x));
+            __m128i b = _mm_loadu_si128((const __m128i*)(r1 + 6 * x));
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));   // Bytes 0..7
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));   // Bytes 8..15
+            __m128i p0 = _mm_add_epi16(lo, _mm_srli_si128(lo, 6));                                 // Lanes 0..2
+            __m128i mid = _mm_or_si128(_mm_srli_si128(lo, 12), _mm_slli_si128(hi, 4));             // Bytes 6..13
+            __m128i p1 = _mm_add_epi16(mid, _mm_srli_si128(mid, 6));
+            __m128i sum = _mm_or_si128(_mm_and_si128(p0, keep3), _mm_slli_si128(_mm_and_si128(p1, keep3), 6));
+            __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+            unsigned char packed[16];
+            _mm_storeu_si128((__m128i*)packed, _mm_packus_epi16(avg, zero));
+            std::memcpy(out + 3 * x, packed, 6);
+        }
+    }
+
+    // Remainder (and any other channel count)
+    for (; x < dw; ++x) {
+        for (int c = 0; c < channels; ++c) {
+            int i = 2 * x * channels + c;
+            int sum = r0[i] + r0[i + channels] + r1[i] + r1[i + channels];
+            out[x * channels + c] = (unsigned char)((sum + 2) / 4);
+        }
+    }
+}
+#endif
+
+// 2x2 box filter into the next level; vectorized when the level halves exactly in both directions
+inline void DownsampleBox(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh, int channels) {
+#if BOING_MIPS_SSE2
+    if (sw == 2 * dw && sh == 2 * dh) {
+        const size_t srcRow = (size_t)sw * (size_t)channels;
+        for (int y = 0; y < dh; ++y) {
+            const unsigned char* r0 = src + (size_t)(2 * y) * srcRow;
+            DownsampleRowSSE2(r0, r0 + srcRow, dst + (size_t)y * (size_t)dw * (size_t)channels, dw, channels);
+        }
+        return;
+    }
+#endif
+    DownsampleBoxScalar(src, sw, sh, dst, dw, dh, channels);
+}
+
+// Fill levels 1..n-1 of a chain whose level 0 is already in place
+inline void BuildMipChain(unsigned char* texels, const TextureMip* mips, int levels, int channels) {
+    for (int level = 1; level < levels; ++level) {
+        const TextureMip& src = mips[level - 1];
+        const TextureMip& dst = mips[level];
+        DownsampleBox(texels + src.offset, src.width, src.height, texels + dst.offset, dst.width, dst.height, channels);
+    }
+}
+
+// Allocate a whole chain for an image and build it (for larger or user-supplied textures)
+inline void BuildMipChainFromImage(const unsigned char* image, int w, int h, int channels,
+    std::vector<unsigned char>& texels, TextureMip* mips, int& levels) {
+    texels.resize(MipChainLayout(w, h, channels, mips, levels));
+    std::memcpy(texels.data(), image, (size_t)w * (size_t)h * (size_t)channels);
+    BuildMipChain(texels.data(), mips, levels, channels);
+}
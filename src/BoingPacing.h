@@ -0,0 +1,103 @@
+// BoingPacing.h — frame pacing and power accounting: how often the saver wakes, ticks and draws
+// Portable (no Windows headers): the saver sleeps on waitable timers, tools/BoingPowerBench.cpp on
+// clock_nanosleep; both take their cadence and deadlines from these types.
+// Frames sit on a grid of deadlines at the cadence's rate. The loop sleeps until the next deadline
+// (or a window message) instead of polling; a late frame restarts the grid rather than bursting
+// to catch up. Each wait may be deferred by a tolerance so the OS can coalesce wakeups.
+
+#pragma once
+
+#include <cstdint>
+
+#include "BoingSettings.h"
+
+const uint32_t PACING_DEFAULT_FPS = 60;     // Full cadence when the display rate is unknown
+const uint32_t PACING_MIN_FPS = 10;         // FrameRateCap range
+const uint32_t PACING_MAX_FPS = 240;
+const uint32_t PACING_LOW_POWER_FPS = 30;
+const uint32_t PACING_HIDDEN_FPS = 2;       // Nothing on screen: display changes and telemetry only
+
+// Longest simulation step per frame: half again the slowest cadence's interval, so every cap
+// runs in real time and only a real stall (a drag, a breakpoint) is clamped
+const float PACING_MAX_STEP = 1.5f / (float)PACING_MIN_FPS;
+
+enum PacingCadence : int {
+    CADENCE_FULL,          // Frame rate cap (the display rate by default)
+    CADENCE_LOW_POWER,     // Battery, dimmed display or LowPower = 1
+    CADENCE_HIDDEN         // Display off: no simulation or drawing, housekeeping only
+};
+
+// What the machine is doing, kept current from power notifications
+struct PowerState {
+    bool displayOn = true;
+    bool displayDimmed = false;
+    bool onBattery = false;
+};
+
+inline PacingCadence ChooseCadence(const PowerState& s, int lowPower) {
+    if (!s.displayOn) return CADENCE_HIDDEN;
+    if (lowPower == LOW_POWER_ALWAYS) return CADENCE_LOW_POWER;
+    if (lowPower == LOW_POWER_AUTO && (s.onBattery || s.displayDimmed)) return CADENCE_LOW_POWER;
+    return CADENCE_FULL;
+}
+
+inline const char* CadenceName(PacingCadence c) {
+    return c == CADENCE_FULL ? "full" : (c == CADENCE_LOW_POWER ? "low-power" : "hidden");
+}
+
+class FramePacer {
+public:
+    // Full-cadence rate: the FrameRateCap setting, or the display's refresh rate when that is 0
+    void Configure(uint32_t capFps, uint32_t displayHz) {
+        uint32_t fps = capFps ? capFps : (displayHz > 1 ? displayHz : PACING_DEFAULT_FPS);
+        if (fps < PACING_MIN_FPS) fps = PACING_MIN_FPS;
+        if (fps > PACING_MAX_FPS) fps = PACING_MAX_FPS;
+        fullFps_ = fps;
+        deadline_ = 0;
+    }
+
+    uint32_t Fps(PacingCadence c) const {
+        if (c == CADENCE_HIDDEN) return PACING_HIDDEN_FPS;
+        if (c == CADENCE_LOW_POWER) return fullFps_ < PACING_LOW_POWER_FPS ? fullFps_ : PACING_LOW_POWER_FPS;
+        return fullFps_;
+    }
+
+    uint64_t IntervalNs(PacingCadence c) const { return 1000000000ull / Fps(c); }
+
+    // How late a wakeup may come so the OS can batch it with others: nothing at full cadence
+    // (frames would judder), a quarter of the interval at low power, half of it when hidden
+    uint64_t ToleranceNs(PacingCadence c) const {
+        if (c == CADENCE_HIDDEN) return IntervalNs(c) / 2;
+        if (c == CADENCE_LOW_POWER) return IntervalNs(c) / 4;
+        return 0;
+    }
+
+    // Deadline of the next frame, for a frame finishing at nowNs; at or before nowNs means run now
+    uint64_t NextDeadline(uint64_t nowNs, PacingCadence c) {
+        if (c != cadence_ || deadline_ == 0) deadline_ = nowNs;    // New cadence, new grid
+        cadence_ = c;
+        deadline_ += IntervalNs(c);
+        if (deadline_ < nowNs) deadline_ = nowNs;                  // More than a frame behind
+        return deadline_;
+    }
+
+private:
+    uint32_t      fullFps_ = PACING_DEFAULT_FPS;
+    PacingCadence cadence_ = CADENCE_FULL;
+    uint64_t      deadline_ = 0;
+};
+
+// Main thread wakeups and frames over a reporting interval, with the process CPU time they cost
+struct PowerCounters {
+    uint64_t wakeups = 0;          // Times the loop came back from a wait (timer, message or none due)
+    uint64_t messageWakeups = 0;   // ...of those, early for a window message
+    uint64_t frames = 0;           // Simulation steps, each followed by a draw (outputs may still skip present)
+};
+
+inline double CpuMsPerMinute(uint64_t cpuNs, double seconds) {
+    return seconds > 0.0 ? (double)cpuNs / 1e6 * 60.0 / seconds : 0.0;
+}
+
+inline double PerSecond(uint64_t count, double seconds) {
+    return seconds > 0.0 ? (double)count / seconds : 0.0;
+}
@@ -0,0 +1,217 @@
+// BoingParticles.h — fixed-capacity impact particles (dust and sparkles) in structure-of-arrays form
+// Portable (no Windows or GL headers). One pool serves every world: particles carry a world index,
+// the update integrates four at a time (SSE where available), and the packed vertices come out
+// grouped by world so each output draws its own range with a single call.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOING_PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+const size_t PARTICLE_CAPACITY = 8192;    // Multiple of 4 (whole SIMD groups)
+const size_t PARTICLE_MAX_WORLDS = 32;
+
+// Interleaved color + position, the GL_C4UB_V3F layout (rgba holds bytes R, G, B, A in memory
+// order on little-endian targets, i.e. a COLORREF with alpha in the top byte)
+struct ParticleVertex {
+    uint32_t rgba = 0;
+    float    x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+class ParticlePool {
+public:
+    // Spray count particles from a contact point, away from the surface normal (nx, ny, nz).
+    // floorY is the world's floor; color is 0x00BBGGRR. Returns how many fitted in the pool.
+    size_t Emit(size_t world, float px, float py, float pz, float nx, float ny, float nz,
+        float speed, float floorY, uint32_t color, size_t count) {
+        if (world >= PARTICLE_MAX_WORLDS) return 0;
+        if (count > PARTICLE_CAPACITY - count_) count = PARTICLE_CAPACITY - count_;
+        for (size_t n = 0; n < count; ++n) {
+            const size_t i = count_++;
+            // Direction: the normal plus a random offset from the unit cube, so the spray is a wide cone
+            float dx = nx + 1.6f * (Random() - 0.5f);
+            float dy = ny + 1.6f * (Random() - 0.5f);
+            float dz = nz + 1.6f * (Random() - 0.5f);
+            float s = speed * (0.4f + 0.6f * Random());
+            x_[i] = px; y_[i] = py; z_[i] = pz;
+            vx_[i] = dx * s; vy_[i] = dy * s; vz_[i] = dz * s;
+            floor_[i] = floorY;
+            life_[i] = 0.5f + 0.7f * Random();
+            fade_[i] = 255.0f / life_[i];
+            color_[i] = color & 0x00FFFFFFu;
+            world_[i] = (uint8_t)world;
+        }
+        return count;
+    }
+
+    // Advance every particle by dt: gravity, air drag, a damped floor bounce, fade; then drop the
+    // dead ones and rebuild the per-world vertex ranges
+    void Update(float dt, float gravity) {
+        Integrate(0, count_, dt, gravity);
+        FinishUpdate();
+    }
+
+    // The two halves of Update, for callers that spread the integration over threads: particles
+    // in [begin, end) are independent of the rest, so disjoint ranges may run at once. begin must be
+    // a multiple of 4 (the SIMD loads are aligned); the groups stop short of end and the scalar loop
+    // finishes the tail, so nothing past end is touched.
+    void Integrate(size_t begin, size_t end, float dt, float gravity) {
+        const float drag = 1.0f / (1.0f + 1.5f * dt);
+        const float gdt = gravity * dt;
+        const float rest = -0.35f;
+        size_t i = begin;
+#if BOING_PARTICLES_SSE
+        const __m128 vdt = _mm_set1_ps(dt), vdrag = _mm_set1_ps(drag), vgdt = _mm_set1_ps(gdt), vrest = _mm_set1_ps(rest);
+        for (; i + 4 <= end; i += 4) {
+            __m128 vx = _mm_mul_ps(_mm_load_ps(vx_ + i), vdrag);
+            __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(vy_ + i), vgdt), vdrag);
+            __m128 vz = _mm_mul_ps(_mm_load_ps(vz_ + i), vdrag);
+            __m128 x = _mm_add_ps(_mm_load_ps(x_ + i), _mm_mul_ps(vx, vdt));
+            __m128 y = _mm_add_ps(_mm_load_ps(y_ + i), _mm_mul_ps(vy, vdt));
+            __m128 z = _mm_add_ps(_mm_load_ps(z_ + i), _mm_mul_ps(vz, vdt));
+            __m128 fy = _mm_load_ps(floor_ + i);
+            __m128 below = _mm_cmplt_ps(y, fy);
+            y = _mm_or_ps(_mm_and_ps(below, fy), _mm_andnot_ps(below, y));
+            vy = _mm_or_ps(_mm_and_ps(below, _mm_mul_ps(vy, vrest)), _mm_andnot_ps(below, vy));
+            _mm_store_ps(x_ + i, x); _mm_store_ps(y_ + i, y); _mm_store_ps(z_ + i, z);
+            _mm_store_ps(vx_ + i, vx); _mm_store_ps(vy_ + i, vy); _mm_store_ps(vz_ + i, vz);
+            _mm_store_ps(life_ + i, _mm_sub_ps(_mm_load_ps(life_ + i), vdt));
+        }
+#endif
+        for (; i < end; ++i) {
+            vx_[i] *= drag;
+            vy_[i] = (vy_[i] + gdt) * drag;
+            vz_[i] *= drag;
+            x_[i] += vx_[i] * dt;
+            y_[i] += vy_[i] * dt;
+            z_[i] += vz_[i] * dt;
+            if (y_[i] < floor_[i]) { y_[i] = floor_[i]; vy_[i] *= rest; }
+            life_[i] -= dt;
+        }
+    }
+
+    void FinishUpdate() {
+        Compact();
+        if (count_) ++updates_;
+    }
+
+    void Clear() {
+        count_ = 0;
+        for (size_t w = 0; w <= PARTICLE_MAX_WORLDS; ++w) first_[w] = 0;
+    }
+
+    size_t Live() const { return count_; }
+    size_t LiveIn(size_t world) const { return first_[world + 1] - first_[world]; }
+    const ParticleVertex* VerticesOf(size_t world) const { return verts_ + first_[world]; }
+    uint32_t Updates() const { return updates_; }     // Changes whenever live particles moved
+
+private:
+    // Keep the live particles packed at the front (a dead slot takes the last live particle, so the
+    // cost follows the number of deaths), then write their vertices grouped by world
+    void Compact() {
+        size_t n = count_;
+        for (size_t i = 0; i < n;) {
+            if (life_[i] > 0.0f) { ++i; continue; }
+            --n;
+            x_[i] = x_[n]; y_[i] = y_[n]; z_[i] = z_[n];
+            vx_[i] = vx_[n]; vy_[i] = vy_[n]; vz_[i] = vz_[n];
+            floor_[i] = floor_[n]; life_[i] = life_[n]; fade_[i] = fade_[n];
+            color_[i] = color_[n]; world_[i] = world_[n];
+        }
+        count_ = n;
+
+        // Usual case: every live particle is in the same world, so vertices follow particle order
+        const uint8_t world0 = n ? world_[0] : 0;
+        bool oneWorld = true;
+        for (size_t i = 0; i < n; ++i) oneWorld &= (world_[i] == world0);
+
+        size_t i = 0;
+        if (oneWorld) {
+            for (size_t w = 0; w <= PARTICLE_MAX_WORLDS; ++w) first_[w] = (w <= world0) ? 0 : n;
+#if BOING_PARTICLES_SSE
+            const __m128 maxAlpha = _mm_set1_ps(255.0f);
+            for (; i + 4 <= n; i += 4) {
+                __m128i alpha = _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_load_ps(life_ + i), _mm_loadu_ps(fade_ + i)), maxAlpha));
+                __m128i rgba = _mm_or_si128(_mm_loadu_si128((const __m128i*)(color_ + i)), _mm_slli_epi32(alpha, 24));
+                __m128 c = _mm_castsi128_ps(rgba), x = _mm_load_ps(x_ + i), y = _mm_load_ps(y_ + i), z = _mm_load_ps(z_ + i);
+                _MM_TRANSPOSE4_PS(c, x, y, z);      // Four (rgba, x, y, z) vertices
+                _mm_storeu_ps((float*)(verts_ + i), c);
+                _mm_storeu_ps((float*)(verts_ + i + 1), x);
+                _mm_storeu_ps((float*)(verts_ + i + 2), y);
+                _mm_storeu_ps((float*)(verts_ + i + 3), z);
+            }
+#endif
+            for (; i < n; ++i) verts_[i] = Vertex(i);
+            return;
+        }
+
+        size_t perWorld[PARTICLE_MAX_WORLDS] = {};
+        for (i = 0; i < n; ++i) ++perWorld[world_[i]];
+        size_t cursor[PARTICLE_MAX_WORLDS];
+        first_[0] = 0;
+        for (size_t w = 0; w < PARTICLE_MAX_WORLDS; ++w) {
+            cursor[w] = first_[w];
+            first_[w + 1] = first_[w] + perWorld[w];
+        }
+        for (i = 0; i < n; ++i) verts_[cursor[world_[i]]++] = Vertex(i);
+    }
+
+    ParticleVertex Vertex(size_t i) const {
+        float a = life_[i] * fade_[i];
+        ParticleVertex v;
+        v.rgba = color_[i] | ((uint32_t)(int)(a > 255.0f ? 255.0f : a) << 24);   // Signed convert is the cheap one
+        v.x = x_[i]; v.y = y_[i]; v.z = z_[i];
+        return v;
+    }
+
+    // xorshift32 in [0, 1)
+    float Random() {
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        return (float)(seed_ >> 8) * (1.0f / 16777216.0f);
+    }
+
+    alignas(16) float x_[PARTICLE_CAPACITY] = {};
+    alignas(16) float y_[PARTICLE_CAPACITY] = {};
+    alignas(16) float z_[PARTICLE_CAPACITY] = {};
+    alignas(16) float vx_[PARTICLE_CAPACITY] = {};
+    alignas(16) float vy_[PARTICLE_CAPACITY] = {};
+    alignas(16) float vz_[PARTICLE_CAPACITY] = {};
+    alignas(16) float floor_[PARTICLE_CAPACITY] = {};
+    alignas(16) float life_[PARTICLE_CAPACITY] = {};
+    float          fade_[PARTICLE_CAPACITY] = {};      // Alpha per second of remaining life
+    uint32_t       color_[PARTICLE_CAPACITY] = {};
+    uint8_t        world_[PARTICLE_CAPACITY] = {};
+    ParticleVertex verts_[PARTICLE_CAPACITY];
+    size_t         first_[PARTICLE_MAX_WORLDS + 1] = {};
+    size_t         count_ = 0;
+    uint32_t       updates_ = 0;
+    uint32_t       seed_ = 0x9E3779B9u;
+};
+
+// Emission throttle: scales emission down as the (smoothed) frame time approaches the budget, so
+// effects never push a slow machine further behind
+class ParticleThrottle {
+public:
+    explicit ParticleThrottle(float budgetMs) : budgetMs_(budgetMs) {}
+
+    void NoteFrameTime(float ms) { smoothedMs_ += 0.1f * (ms - smoothedMs_); }
+
+    // 1 up to half the budget, falling to 0 at the budget
+    float Scale() const {
+        float s = 2.0f * (1.0f - smoothedMs_ / budgetMs_);
+        return s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+    }
+
+    size_t Throttle(size_t wanted) const { return (size_t)((float)wanted * Scale() + 0.5f); }
+
+private:
+    float budgetMs_;
+    float smoothedMs_ = 0.0f;
+};
@@ -0,0 +1,250 @@
+// BoingReplay.h — compact binary log of a simulation run (record in the saver, replay anywhere)
+// Portable (no Windows headers). Layout, little-endian:
+//   header  "BBRL", version, SimParams, settings as (name length, name, value) pairs ending in length 0
+//   LAYOUT  continued flag, ball count, then per ball BallState + WorldBounds; written at the start and
+//           after any resize or monitor change. Replay adopts it, after checking its own balls against
+//           it when the flag says the balls carried on from the previous tick (only the bounds moved)
+//   TICK    simulated dt passed to every ball this main loop iteration
+//   EVENT   ball index and the impacts of the preceding TICK, each as SimEvent bits and its time into
+//           the tick (only for balls that hit something)
+//   END     number of ticks written
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BoingSettings.h"
+#include "BoingSim.h"
+
+const uint32_t REPLAY_MAGIC = 0x4C524242;   // "BBRL"
+const uint32_t REPLAY_VERSION = 2;   // 2 = continuous collision, timed impacts
+const size_t   REPLAY_MAX_BALLS = 256;
+
+enum ReplayOp : uint8_t {
+    REPLAY_OP_LAYOUT = 1,
+    REPLAY_OP_TICK = 2,
+    REPLAY_OP_EVENT = 3,
+    REPLAY_OP_END = 4
+};
+
+// Buffered writer: appends to a fixed buffer and only hands full buffers to stdio, so recording
+// adds no heap allocations to the render loop
+class ReplayWriter {
+public:
+    ~ReplayWriter() { Close(); }
+
+    bool Open(std::FILE* fp, const SimParams& params, const SaverSettings& settings) {
+        Close();
+        fp_ = fp;
+        if (!fp_) return false;
+        ticks_ = 0;
+        Put32(REPLAY_MAGIC);
+        Put32(REPLAY_VERSION);
+        PutF(params.radius); PutF(params.gravity); PutF(params.spinSpeed); PutF(params.bounceVy);
+
+        // The settings snapshot goes through the regular save path, so it stays in step with the schema
+        SettingsSink sink(*this);
+        SaveSettings(sink, settings);
+        Put8(0);
+        return true;
+    }
+
+    bool IsOpen() const { return fp_ != nullptr; }
+
+    void Layout(size_t count, const BallState* balls, const WorldBounds* bounds, bool continued) {
+        if (!fp_) return;
+        Put8(REPLAY_OP_LAYOUT);
+        Put8(continued ? 1 : 0);
+        Put16((uint16_t)count);
+        for (size_t i = 0; i < count; ++i) {
+            const BallState& b = balls[i];
+            PutF(b.x); PutF(b.y); PutF(b.z); PutF(b.vx); PutF(b.vy); PutF(b.vz); PutF(b.spin);
+            Put32((uint32_t)b.spinDir);
+            PutF(bounds[i].wallX); PutF(bounds[i].wallZ); PutF(bounds[i].floorY);
+        }
+    }
+
+    void Tick(float dt) {
+        if (!fp_) return;
+        Put8(REPLAY_OP_TICK);
+        PutF(dt);
+        ++ticks_;
+    }
+
+    void Impacts(size_t ball, const SimImpacts& impacts) {
+        if (!fp_ || impacts.count == 0) return;
+        Put8(REPLAY_OP_EVENT);
+        Put16((uint16_t)ball);
+        Put8((uint8_t)impacts.count);
+        for (int i = 0; i < impacts.count; ++i) {
+            Put8((uint8_t)impacts.list[i].event);
+            PutF(impacts.list[i].t);
+        }
+    }
+
+    void Close() {
+        if (!fp_) return;
+        Put8(REPLAY_OP_END);
+        Put32(ticks_);
+        Flush();
+        std::fclose(fp_);
+        fp_ = nullptr;
+    }
+
+private:
+    class SettingsSink : public SettingsBackend {
+    public:
+        explicit SettingsSink(ReplayWriter& w) : w_(w) {}
+        bool OpenForRead() override { return false; }
+        bool OpenForWrite() override { return true; }
+        bool ReadValue(const wchar_t*, uint32_t&) override { return false; }
+        void WriteValue(const wchar_t* name, uint32_t value) override {
+            size_t len = std::wcslen(name);
+            w_.Put8((uint8_t)len);
+            for (size_t i = 0; i < len; ++i) w_.Put8((uint8_t)name[i]);
+            w_.Put32(value);
+        }
+        void Close() override {}
+    private:
+        ReplayWriter& w_;
+    };
+
+    void Put8(uint8_t v) {
+        if (used_ == sizeof(buf_)) Flush();
+        buf_[used_++] = v;
+    }
+    void Put16(uint16_t v) { Put8((uint8_t)v); Put8((uint8_t)(v >> 8)); }
+    void Put32(uint32_t v) { for (int i = 0; i < 4; ++i) Put8((uint8_t)(v >> (8 * i))); }
+    void PutF(float f) { uint32_t u; std::memcpy(&u, &f, 4); Put32(u); }
+    void Flush() {
+        if (fp_ && used_) std::fwrite(buf_, 1, used_, fp_);
+        used_ = 0;
+    }
+
+    std::FILE*    fp_ = nullptr;
+    uint32_t      ticks_ = 0;
+    size_t        used_ = 0;
+    unsigned char buf_[64 * 1024];
+};
+
+// Whole-log reader (tools and tests); Next() walks the records in order
+struct ReplayRecord {
+    ReplayOp op = REPLAY_OP_END;
+    float    dt = 0.0f;                         // TICK
+    uint16_t ball = 0;                          // EVENT
+    SimImpacts impacts;                         // EVENT
+    uint32_t ticks = 0;                         // END
+    bool     continued = false;                 // LAYOUT
+    std::vector<BallState>   balls;             // LAYOUT
+    std::vector<WorldBounds> bounds;            // LAYOUT
+};
+
+class ReplayReader {
+public:
+    SimParams     params;
+    SaverSettings settings;
+
+    bool Open(const std::vector<unsigned char>& data) {
+        data_ = &data;
+        pos_ = 0;
+        uint32_t magic = 0, version = 0;
+        if (!Get32(magic) || !Get32(version) || magic != REPLAY_MAGIC || version != REPLAY_VERSION) return false;
+        if (!GetF(params.radius) || !GetF(params.gravity) || !GetF(params.spinSpeed) || !GetF(params.bounceVy)) return false;
+
+        MemorySettingsBackend backend;
+        for (;;) {
+            uint8_t len = 0;
+            if (!Get8(len)) return false;
+            if (len == 0) break;
+            std::wstring name;
+            for (uint8_t i = 0; i < len; ++i) {
+                uint8_t c = 0;
+                if (!Get8(c)) return false;
+                name.push_back((wchar_t)c);
+            }
+            uint32_t value = 0;
+            if (!Get32(value)) return false;
+            backend.values[name] = value;
+        }
+        settings = LoadSettings(backend);
+        return true;
+    }
+
+    // False at the end of the log or on a truncated record
+    bool Next(ReplayRecord& r) {
+        uint8_t op = 0;
+        if (!Get8(op)) return false;
+        r.op = (ReplayOp)op;
+        switch (op) {
+        case REPLAY_OP_LAYOUT: {
+            uint8_t continued = 0;
+            uint16_t count = 0;
+            if (!Get8(continued) || !Get16(count) || count > REPLAY_MAX_BALLS) return false;
+            r.continued = continued != 0;
+            r.balls.resize(count);
+            r.bounds.resize(count);
+            for (uint16_t i = 0; i < count; ++i) {
+                BallState& b = r.balls[i];
+                WorldBounds& w = r.bounds[i];
+                uint32_t dir = 0;
+                if (!GetF(b.x) || !GetF(b.y) || !GetF(b.z) || !GetF(b.vx) || !GetF(b.vy) || !GetF(b.vz) ||
+                    !GetF(b.spin) || !Get32(dir) || !GetF(w.wallX) || !GetF(w.wallZ) || !GetF(w.floorY)) return false;
+                b.spinDir = (int)dir;
+            }
+            return true;
+        }
+        case REPLAY_OP_TICK:
+            return GetF(r.dt);
+        case REPLAY_OP_EVENT: {
+            uint8_t count = 0;
+            if (!Get16(r.ball) || !Get8(count) || count > SIM_MAX_IMPACTS) return false;
+            r.impacts.count = count;
+            for (uint8_t i = 0; i < count; ++i) {
+                uint8_t ev = 0;
+                if (!Get8(ev) || !GetF(r.impacts.list[i].t)) return false;
+                r.impacts.list[i].event = ev;
+            }
+            return true;
+        }
+        case REPLAY_OP_END:
+            return Get32(r.ticks);
+        default:
+            return false;
+        }
+    }
+
+private:
+    bool Get8(uint8_t& v) {
+        if (pos_ >= data_->size()) return false;
+        v = (*data_)[pos_++];
+        return true;
+    }
+    bool Get16(uint16_t& v) {
+        uint8_t a, b;
+        if (!Get8(a) || !Get8(b)) return false;
+        v = (uint16_t)(a | (b << 8));
+        return true;
+    }
+    bool Get32(uint32_t& v) {
+        v = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint8_t b;
+            if (!Get8(b)) return false;
+            v |= (uint32_t)b << (8 * i);
+        }
+        return true;
+    }
+    bool GetF(float& f) {
+        uint32_t u;
+        if (!Get32(u)) return false;
+        std::memcpy(&f, &u, 4);
+        return true;
+    }
+
+    const std::vector<unsigned char>* data_ = nullptr;
+    size_t pos_ = 0;
+};
@@ -0,0 +1,155 @@
+// BoingScene.h — what a frame shows, independent of how it is drawn: camera, grid, shadow and ball
+// transforms, and the fixed-function lighting terms
+// Portable (no Windows or GL headers). The saver's GL path and the CPU reference renderer in
+// tools/BoingGolden.cpp both build their frames from these definitions, so a change here (or to
+// the meshes and texture in BoingAssets.h) shows up in the golden-image check.
+
+#pragma once
+
+#include <cmath>
+
+#include "BoingMemory.h"
+#include "BoingSim.h"
+
+// Camera: looks down -z from SCENE_CAMERA_Z, the world is centred on the origin
+const float SCENE_FOV_Y_DEG = 45.0f;
+const float SCENE_NEAR = 0.1f;
+const float SCENE_FAR = 50.0f;
+const float SCENE_CAMERA_Z = 2.0f;
+
+// Grid: floor and back wall lines, every 0.2 units over [-1, 1]
+const float SCENE_GRID_COLOR[3] = { 0.3f, 0.6f, 1.0f };
+const float SCENE_GRID_LINE_WIDTH = 2.0f;
+
+// Shadows: the ball mesh squashed onto the floor and the back wall, drawn in translucent black
+const float SCENE_FLOOR_SHADOW_ALPHA = 0.4f;
+const float SCENE_WALL_SHADOW_ALPHA = 0.3f;
+const float SCENE_FLOOR_SHADOW_LIFT = 0.001f;    // Keeps the floor shadow off the grid plane
+const float SCENE_WALL_Z = -1.0f;
+
+const float SCENE_PARTICLE_POINT_SIZE = 3.0f;
+
+// Lighting: one directional light given in eye space, GL's default material (no color material)
+const float SCENE_LIGHT_DIR[4] = { -0.5f, 0.8f, 0.6f, 0.0f };
+const float SCENE_LIGHT_AMBIENT[4] = { 0.4f, 0.4f, 0.4f, 1.0f };
+const float SCENE_LIGHT_DIFFUSE[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+const float SCENE_GLOBAL_AMBIENT[4] = { 0.3f, 0.3f, 0.3f, 1.0f };
+const float SCENE_MATERIAL_AMBIENT[4] = { 0.2f, 0.2f, 0.2f, 1.0f };
+const float SCENE_MATERIAL_DIFFUSE[4] = { 0.8f, 0.8f, 0.8f, 1.0f };
+
+// World bounds seen by a viewport of w x h pixels: the walls sit at the edges of the view at the
+// ball plane (z = 0) and the floor at its bottom
+inline WorldBounds SceneBoundsForSize(int w, int h) {
+    if (w <= 0) w = 1;
+    if (h <= 0) h = 1;
+
+    float fovRadians = SCENE_FOV_Y_DEG * (3.14159265f / 180.0f);
+    float aspect = (float)w / (float)h;
+
+    float halfHeight = tanf(fovRadians / 2.0f) * SCENE_CAMERA_Z;
+    float halfWidth = halfHeight * aspect;
+
+    WorldBounds b;
+    b.wallX = halfWidth;
+    b.wallZ = halfWidth;
+    b.floorY = -halfHeight;
+    return b;
+}
+
+// Column-major perspective projection, the matrix gluPerspective builds
+inline void ScenePerspective(float m[16], float aspect) {
+    const float f = 1.0f / tanf(SCENE_FOV_Y_DEG * (3.14159265f / 180.0f) / 2.0f);
+    for (int i = 0; i < 16; ++i) m[i] = 0.0f;
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (SCENE_FAR + SCENE_NEAR) / (SCENE_NEAR - SCENE_FAR);
+    m[11] = -1.0f;
+    m[14] = 2.0f * SCENE_FAR * SCENE_NEAR / (SCENE_NEAR - SCENE_FAR);
+}
+
+// Every grid line in world space, in drawing order: line(x0, y0, z0, x1, y1, z1)
+template <typename LineFn>
+inline void ForEachGridLine(float floorY, LineFn&& line) {
+    for (float i = -1.0f; i <= 1.0f; i += 0.2f) {
+        line(i, floorY, -1.0f, i, floorY, 1.0f);
+        line(-1.0f, floorY, i, 1.0f, floorY, i);
+    }
+    for (float x = -1.0f; x <= 1.0f; x += 0.2f) {
+        line(x, floorY, SCENE_WALL_Z, x, floorY + 2.0f, SCENE_WALL_Z);
+    }
+    for (float y = floorY; y <= floorY + 2.0f; y += 0.2f) {
+        line(-1.0f, y, SCENE_WALL_Z, 1.0f, y, SCENE_WALL_Z);
+    }
+}
+
+// Column-major translate * scale for shadow instances (camera sits at z = +2)
+inline void SceneShadowMatrix(float m[16], float x, float y, float z, float sx, float sy, float sz) {
+    for (int i = 0; i < 16; ++i) m[i] = 0.0f;
+    m[0] = sx; m[5] = sy; m[10] = sz; m[15] = 1.0f;
+    m[12] = x; m[13] = y; m[14] = z - SCENE_CAMERA_Z;
+}
+
+inline void SceneFloorShadowMatrix(float m[16], float x, float floorY, float z) {
+    SceneShadowMatrix(m, x, floorY + SCENE_FLOOR_SHADOW_LIFT, z, 1.0f, 0.1f, 1.0f);
+}
+
+inline void SceneWallShadowMatrix(float m[16], float x, float y) {
+    SceneShadowMatrix(m, x, y, SCENE_WALL_Z, 1.0f, 1.0f, 0.1f);
+}
+
+// Column-major translate * Rx(90) * Ry(-15) * Rz(spin), matching the original glRotatef chain
+inline void SceneBallMatrix(float m[16], float x, float y, float z, float spinDeg) {
+    const float deg = 3.14159265f / 180.0f;
+    const float ct = cosf(-15.0f * deg), st = sinf(-15.0f * deg);
+    const float cs = cosf(spinDeg * deg), ss = sinf(spinDeg * deg);
+
+    // Ry(-15) * Rz(spin), then Rx(90) maps (x, y, z) -> (x, -z, y)
+    float ryz[3][3] = {
+        { ct * cs, -ct * ss, st },
+        { ss,       cs,      0.0f },
+        { -st * cs, st * ss, ct }
+    };
+    float r[3][3] = {
+        { ryz[0][0], ryz[0][1], ryz[0][2] },
+        { -ryz[2][0], -ryz[2][1], -ryz[2][2] },
+        { ryz[1][0], ryz[1][1], ryz[1][2] }
+    };
+
+    for (int c = 0; c < 3; ++c) {
+        for (int rr = 0; rr < 3; ++rr) m[c * 4 + rr] = r[rr][c];
+        m[c * 4 + 3] = 0.0f;
+    }
+    m[12] = x; m[13] = y; m[14] = z - SCENE_CAMERA_Z; m[15] = 1.0f;
+}
+
+// Per-frame ball instances in structure-of-arrays form, drawn in grouped passes: every floor
+// shadow, then every wall shadow, then every ball. The arrays come from a frame arena, so building
+// a batch never touches the heap.
+const size_t BALL_BATCH_CAPACITY = 16;
+
+struct BallBatch {
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+    float* spin = nullptr;        // Degrees around the ball's pole
+    float* floorY = nullptr;      // Floor height under each ball (floor shadow plane)
+    size_t count = 0, capacity = 0;
+
+    // Start an empty batch backed by this frame's arena
+    void begin(FrameArena& arena, size_t cap) {
+        count = 0;
+        x = arena.AllocArray<float>(cap);
+        y = arena.AllocArray<float>(cap);
+        z = arena.AllocArray<float>(cap);
+        spin = arena.AllocArray<float>(cap);
+        floorY = arena.AllocArray<float>(cap);
+        capacity = (x && y && z && spin && floorY) ? cap : 0;
+    }
+    size_t size() const { return count; }
+    void add(float bx, float by, float bz, float bspin, float bfloorY) {
+        if (count == capacity) return;
+        x[count] = bx; y[count] = by; z[count] = bz;
+        spin[count] = bspin; floorY[count] = bfloorY;
+        ++count;
+    }
+};
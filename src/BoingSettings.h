@@ -0,0 +1,218 @@
+// BoingSettings.h — settings snapshot, versioned defaults and storage backends for BoingBallSaver
+// Portable (no Windows headers): the registry backend lives in the saver, the memory and file
+// backends here can be used by tools and on other platforms.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <map>
+#include <string>
+
+// Settings schema version
+// 1 = original eight values, 2 = adds BallImpostor and the Spanned monitor mode,
+// 3 = adds ImpactParticles, 4 = adds WorkerThreads, 5 = adds FrameExport, 6 = adds Renderer,
+// 7 = adds FrameRateCap and LowPower
+const int SETTINGS_VERSION = 7;
+
+// Multi-monitor modes
+const int MONITOR_MODE_SINGLE = 0;
+const int MONITOR_MODE_EXTENDED = 1;
+const int MONITOR_MODE_REPLICATED = 2;
+const int MONITOR_MODE_UNIFIED = 3;
+const int MONITOR_MODE_SPANNED = 4;
+
+// Renderers
+const int RENDERER_AUTO = 0;          // Core-profile shaders where the driver has GL 3.3, else fixed function
+const int RENDERER_FIXED_FUNCTION = 1;
+
+// Low-power policies
+const int LOW_POWER_AUTO = 0;          // On battery or with the display dimmed
+const int LOW_POWER_ALWAYS = 1;
+const int LOW_POWER_NEVER = 2;
+
+// Immutable snapshot of every user setting, loaded once per process
+struct SaverSettings {
+    int      version = SETTINGS_VERSION;
+    bool     floorShadow = true;
+    bool     wallShadow = true;
+    bool     grid = true;
+    bool     sound = true;
+    uint32_t bgColor = 0x00C0C0C0;    // COLORREF layout (0x00BBGGRR), RGB(192, 192, 192)
+    int      geometryMode = 1;        // 1 = low, 0 = high (kept same semantics as prior)
+    bool     ballLighting = true;
+    int      multiMonitorMode = MONITOR_MODE_SINGLE;
+    bool     impostor = false;        // Draw the ball from a pre-rendered spin atlas
+    bool     impactParticles = false; // Dust and sparkles where the ball hits the floor and walls
+    uint32_t workerThreads = 0;       // Cap on job system threads, 0 = one per core (no dialog control)
+    uint32_t frameExport = 0;         // Shared-memory export ring slots per output, 0 = off (no dialog control)
+    int      renderer = RENDERER_AUTO; // RENDERER_* (no dialog control)
+    uint32_t frameRateCap = 0;        // Frames per second, 0 = the display's refresh rate (no dialog control)
+    int      lowPower = LOW_POWER_AUTO; // LOW_POWER_* (no dialog control)
+};
+
+// Defaults for every setting; no schema version has changed a default, only added values
+inline SaverSettings DefaultSettings() {
+    return SaverSettings();
+}
+
+// What the dialog's Restore button resets to: defaults for the values it has controls for, the
+// registry-only values kept as they are (they would otherwise be lost on OK)
+inline SaverSettings DialogDefaults(const SaverSettings& current) {
+    SaverSettings s = DefaultSettings();
+    s.workerThreads = current.workerThreads;
+    s.frameExport = current.frameExport;
+    s.renderer = current.renderer;
+    s.frameRateCap = current.frameRateCap;
+    s.lowPower = current.lowPower;
+    return s;
+}
+
+// Highest multi-monitor mode understood by a schema version
+inline int MaxMonitorModeForVersion(int version) {
+    return (version >= 2) ? MONITOR_MODE_SPANNED : MONITOR_MODE_UNIFIED;
+}
+
+// Storage backend: one open per load/save, then plain DWORD-sized reads and writes
+class SettingsBackend {
+public:
+    virtual ~SettingsBackend() {}
+    virtual bool OpenForRead() = 0;
+    virtual bool OpenForWrite() = 0;
+    virtual bool ReadValue(const wchar_t* name, uint32_t& out) = 0;
+    virtual void WriteValue(const wchar_t* name, uint32_t value) = 0;
+    virtual void Close() = 0;
+};
+
+// In-memory backend (tests, benchmarks, and the defaults-only fallback)
+class MemorySettingsBackend : public SettingsBackend {
+public:
+    std::map<std::wstring, uint32_t> values;
+
+    bool OpenForRead() override { return true; }
+    bool OpenForWrite() override { return true; }
+    bool ReadValue(const wchar_t* name, uint32_t& out) override {
+        auto it = values.find(name);
+        if (it == values.end()) return false;
+        out = it->second;
+        return true;
+    }
+    void WriteValue(const wchar_t* name, uint32_t value) override { values[name] = value; }
+    void Close() override {}
+};
+
+// Plain-text file backend: one "Name=value" per line, read whole on open, written whole on close
+class FileSettingsBackend : public MemorySettingsBackend {
+public:
+    explicit FileSettingsBackend(const std::string& path) : path_(path) {}
+
+    bool OpenForRead() override {
+        values.clear();
+        dirty_ = false;
+        std::FILE* fp = std::fopen(path_.c_str(), "r");
+        if (!fp) return false;
+
+        char line[256];
+        while (std::fgets(line, sizeof(line), fp)) {
+            char* eq = nullptr;
+            for (char* p = line; *p; ++p) { if (*p == '=') { eq = p; break; } }
+            if (!eq) continue;
+            *eq = '\0';
+            std::wstring name;
+            for (const char* p = line; *p; ++p) name.push_back((wchar_t)(unsigned char)*p);
+            values[name] = (uint32_t)std::strtoul(eq + 1, nullptr, 0);
+        }
+        std::fclose(fp);
+        return true;
+    }
+
+    bool OpenForWrite() override {
+        OpenForRead();   // Keep values we do not own
+        return true;
+    }
+
+    void WriteValue(const wchar_t* name, uint32_t value) override {
+        MemorySettingsBackend::WriteValue(name, value);
+        dirty_ = true;
+    }
+
+    void Close() override {
+        if (!dirty_) return;
+        dirty_ = false;
+        std::FILE* fp = std::fopen(path_.c_str(), "w");
+        if (!fp) return;
+        for (const auto& kv : values) {
+            std::string name;
+            for (wchar_t c : kv.first) name.push_back((char)c);
+            std::fprintf(fp, "%s=%lu\n", name.c_str(), (unsigned long)kv.second);
+        }
+        std::fclose(fp);
+    }
+
+private:
+    std::string path_;
+    bool        dirty_ = false;
+};
+
+// Read every setting with a single backend open; missing or out-of-range values keep defaults.
+// Ranges are those of the schema that wrote the values: a mode number its build did not have is
+// not trusted. Values from a newer schema are checked against this one's ranges.
+inline SaverSettings LoadSettings(SettingsBackend& backend) {
+    SaverSettings s = DefaultSettings();
+    if (!backend.OpenForRead()) return s;
+
+    uint32_t v = 0;
+    int storedVersion = 1;   // Values written before versioning are schema 1
+    if (backend.ReadValue(L"SettingsVersion", v) && v >= 1) {
+        storedVersion = (v < (uint32_t)SETTINGS_VERSION) ? (int)v : SETTINGS_VERSION;
+    }
+
+    if (backend.ReadValue(L"FloorShadow", v))      s.floorShadow = (v != 0);
+    if (backend.ReadValue(L"WallShadow", v))       s.wallShadow = (v != 0);
+    if (backend.ReadValue(L"Grid", v))             s.grid = (v != 0);
+    if (backend.ReadValue(L"Sound", v))            s.sound = (v != 0);
+    if (backend.ReadValue(L"BackgroundColor", v))  s.bgColor = v;
+    if (backend.ReadValue(L"GeometryMode", v))     s.geometryMode = (int)v;
+    if (backend.ReadValue(L"BallLighting", v))     s.ballLighting = (v != 0);
+    if (backend.ReadValue(L"MultiMonitorMode", v)) s.multiMonitorMode = (int)v;
+    if (backend.ReadValue(L"BallImpostor", v))     s.impostor = (v != 0);
+    if (backend.ReadValue(L"ImpactParticles", v))  s.impactParticles = (v != 0);
+    if (backend.ReadValue(L"WorkerThreads", v))    s.workerThreads = v;
+    if (backend.ReadValue(L"FrameExport", v))      s.frameExport = v;
+    if (backend.ReadValue(L"Renderer", v))         s.renderer = (int)v;
+    if (backend.ReadValue(L"FrameRateCap", v))     s.frameRateCap = v;
+    if (backend.ReadValue(L"LowPower", v))         s.lowPower = (int)v;
+    backend.Close();
+
+    if (s.multiMonitorMode < 0 || s.multiMonitorMode > MaxMonitorModeForVersion(storedVersion)) {
+        s.multiMonitorMode = DefaultSettings().multiMonitorMode;
+    }
+    if (s.renderer != RENDERER_AUTO && s.renderer != RENDERER_FIXED_FUNCTION) s.renderer = RENDERER_AUTO;
+    if (s.lowPower < LOW_POWER_AUTO || s.lowPower > LOW_POWER_NEVER) s.lowPower = LOW_POWER_AUTO;
+    s.version = SETTINGS_VERSION;     // Saved back in this schema
+    return s;
+}
+
+// Write every setting (and the schema version) with a single backend open
+inline void SaveSettings(SettingsBackend& backend, const SaverSettings& s) {
+    if (!backend.OpenForWrite()) return;
+    backend.WriteValue(L"SettingsVersion", (uint32_t)SETTINGS_VERSION);
+    backend.WriteValue(L"FloorShadow", s.floorShadow ? 1u : 0u);
+    backend.WriteValue(L"WallShadow", s.wallShadow ? 1u : 0u);
+    backend.WriteValue(L"Grid", s.grid ? 1u : 0u);
+    backend.WriteValue(L"Sound", s.sound ? 1u : 0u);
+    backend.WriteValue(L"BackgroundColor", s.bgColor);
+    backend.WriteValue(L"GeometryMode", (uint32_t)s.geometryMode);
+    backend.WriteValue(L"BallLighting", s.ballLighting ? 1u : 0u);
+    backend.WriteValue(L"MultiMonitorMode", (uint32_t)s.multiMonitorMode);
+    backend.WriteValue(L"BallImpostor", s.impostor ? 1u : 0u);
+    backend.WriteValue(L"ImpactParticles", s.impactParticles ? 1u : 0u);
+    backend.WriteValue(L"WorkerThreads", s.workerThreads);
+    backend.WriteValue(L"FrameExport", s.frameExport);
+    backend.WriteValue(L"Renderer", (uint32_t)s.renderer);
+    backend.WriteValue(L"FrameRateCap", s.frameRateCap);
+    backend.WriteValue(L"LowPower", (uint32_t)s.lowPower);
+    backend.Close();
+}
@@ -0,0 +1,154 @@
+// BoingSim.h — ball simulation core (state, bounds, one continuous-collision step and its timed events)
+// Portable (no Windows or GL headers) so recorded runs can be replayed headless by tools/BoingReplay.cpp.
+// Determinism: plain float math in a fixed order; build with FMA contraction off (MSVC /fp:precise,
+// GCC/Clang -ffp-contract=off) and replays are bit-exact against the saver on the same architecture.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+struct BallState {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    float vx = 0.8f, vy = 4.5f, vz = 0.0f;
+    float spin = 0.0f;      // Degrees around the ball's pole, kept in [0, 360]
+    int   spinDir = 1;      // Flips on every wall hit
+};
+
+struct WorldBounds {
+    float wallX = 1.0f, wallZ = 1.0f, floorY = -1.0f;
+};
+
+struct SimParams {
+    float radius = 0.25f;
+    float gravity = -9.8f;
+    float spinSpeed = 120.0f;   // Degrees per simulated second
+    float bounceVy = 4.5f;      // Upward speed after every floor bounce
+};
+
+enum SimEvent : uint32_t {
+    SIM_EVENT_NONE = 0,
+    SIM_EVENT_FLOOR = 1,
+    SIM_EVENT_WALL = 2
+};
+
+// Up to this many contacts are resolved inside one step; anything left is clamped at the end
+const int SIM_MAX_IMPACTS = 8;
+
+// A collision inside a step, t seconds after the step began, with the ball centre at that moment
+struct SimImpact {
+    uint32_t event = SIM_EVENT_NONE;
+    float    t = 0.0f;
+    float    x = 0.0f, y = 0.0f, z = 0.0f;
+};
+
+struct SimImpacts {
+    int       count = 0;
+    SimImpact list[SIM_MAX_IMPACTS];
+};
+
+// Time until a wall d units away is reached at closing speed s; -1 when moving away from it
+inline float SimWallHit(float d, float s) {
+    if (d < 0.0f) return 0.0f;
+    return (s > 0.0f) ? d / s : -1.0f;
+}
+
+// Time until a ball c above its resting height, rising at vy under gravity g, comes back down to
+// it; -1 when it never does. Written to avoid cancellation for small c.
+inline float SimFloorHit(float c, float vy, float g) {
+    if (c < 0.0f) return 0.0f;
+    if (g < 0.0f) {
+        float root = sqrtf(vy * vy - 2.0f * g * c);
+        return (vy >= 0.0f) ? (vy + root) / -g : (2.0f * c) / (root - vy);
+    }
+    if (vy < 0.0f) return c / -vy;
+    return -1.0f;
+}
+
+// Move a ball along its exact trajectory (ballistic in y, straight in x and z) for t seconds
+inline void SimAdvance(BallState& b, const SimParams& p, float t) {
+    b.spin += b.spinDir * p.spinSpeed * t;
+    if (b.spin > 360.0f) b.spin -= 360.0f;
+    if (b.spin < 0.0f)   b.spin += 360.0f;
+
+    b.x += b.vx * t;
+    b.y += (b.vy + 0.5f * p.gravity * t) * t;
+    b.vy += p.gravity * t;
+    b.z += b.vz * t;
+}
+
+// Advance one ball by dt simulated seconds with continuous collision: solve for the earliest contact
+// with the floor, side walls or depth walls, move exactly to it, respond, and carry on with the rest
+// of the step. A ball already outside the bounds (they shrank) is put back at once, as contact at t.
+// Returns the SimEvent bits raised; impacts, when given, receives each bounce with its time.
+inline uint32_t StepBall(BallState& b, const WorldBounds& w, const SimParams& p, float dt, SimImpacts* impacts = nullptr) {
+    uint32_t events = SIM_EVENT_NONE;
+    if (impacts) impacts->count = 0;
+
+    const float floorY = w.floorY + p.radius;
+    const float maxX = w.wallX - p.radius, maxZ = w.wallZ - p.radius;
+    float t = 0.0f;
+
+    for (int n = 0; n < SIM_MAX_IMPACTS; ++n) {
+        const float left = dt - t;
+
+        // Earliest contact in what is left of the step (0 = already touching or through)
+        const float toi[5] = {
+            SimFloorHit(b.y - floorY, b.vy, p.gravity),
+            SimWallHit(maxX - b.x, b.vx),
+            SimWallHit(b.x + maxX, -b.vx),
+            SimWallHit(maxZ - b.z, b.vz),
+            SimWallHit(b.z + maxZ, -b.vz)
+        };
+        float hit = left;
+        int which = -1;     // 0 floor, 1 +x, 2 -x, 3 +z, 4 -z
+        for (int i = 0; i < 5; ++i) {
+            if (toi[i] >= 0.0f && toi[i] <= hit) { hit = toi[i]; which = i; }
+        }
+
+        SimAdvance(b, p, hit);
+        t += hit;
+        if (which < 0) return events;
+
+        uint32_t ev = SIM_EVENT_NONE;
+        switch (which) {
+        case 0: b.y = floorY; b.vy = p.bounceVy; ev = SIM_EVENT_FLOOR; break;
+        case 1: b.x = maxX;  b.vx = -fabsf(b.vx); b.spinDir *= -1; ev = SIM_EVENT_WALL; break;
+        case 2: b.x = -maxX; b.vx = +fabsf(b.vx); b.spinDir *= -1; ev = SIM_EVENT_WALL; break;
+        case 3: b.z = maxZ;  b.vz = -fabsf(b.vz); break;
+        case 4: b.z = -maxZ; b.vz = +fabsf(b.vz); break;
+        }
+        if (ev != SIM_EVENT_NONE) {
+            events |= ev;
+            if (impacts) {
+                SimImpact& im = impacts->list[impacts->count++];
+                im.event = ev;
+                im.t = t;
+                im.x = b.x; im.y = b.y; im.z = b.z;
+            }
+        }
+    }
+
+    // Contact budget spent (e.g. a ball pinned in a zero-size world): finish the step and clamp
+    SimAdvance(b, p, dt - t);
+    if (b.y < floorY) { b.y = floorY; b.vy = p.bounceVy; }
+    if (b.x > maxX)  b.x = maxX;
+    if (b.x < -maxX) b.x = -maxX;
+    if (b.z > maxZ)  b.z = maxZ;
+    if (b.z < -maxZ) b.z = -maxZ;
+    return events;
+}
+
+// Bitwise state comparison (replay verification must not treat -0 == +0 or NaN specially)
+inline bool SameBallState(const BallState& a, const BallState& b) {
+    const float fa[7] = { a.x, a.y, a.z, a.vx, a.vy, a.vz, a.spin };
+    const float fb[7] = { b.x, b.y, b.z, b.vx, b.vy, b.vz, b.spin };
+    for (int i = 0; i < 7; ++i) {
+        uint32_t ua, ub;
+        std::memcpy(&ua, &fa[i], 4);
+        std::memcpy(&ub, &fb[i], 4);
+        if (ua != ub) return false;
+    }
+    return a.spinDir == b.spinDir;
+}
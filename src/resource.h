@@ -20,3 +20,6 @@
 #define IDC_MONITOR_REPLICATED 1010
 #define IDC_MONITOR_UNIFIED    1011
 #define IDC_MONITOR_SINGLE	   1012
+#define IDC_IMPOSTOR           1013
+#define IDC_MONITOR_SPANNED    1014
+#define IDC_PARTICLES          1015
@@ -0,0 +1,170 @@
+// BoingAllocCheck.cpp — steady-state heap allocation check for the saver's per-frame work
+// Portable C++17, no Windows or GL headers. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -pthread -Isrc tools/BoingAllocCheck.cpp -o BoingAllocCheck
+//   ./BoingAllocCheck [frames] [outputs] [threads]     (threads 0 = one per core; exit 1 on any allocation)
+// Runs what the main loop does every iteration without a GPU: reset the frame arena, step each
+// output's ball, emit and integrate impact particles on the job system, record the run, and build
+// each output's ball batch from the arena. Every so often an output is unplugged and another one
+// plugged in through the FixedVector, as a display change does. Counts operator new the way the
+// saver does and fails if any frame past the warm-up allocates (the saver only asserts this in
+// debug builds). Also checks the output list's erase contract: later outputs move down one slot.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "BoingJobs.h"
+#include "BoingMemory.h"
+#include "BoingParticles.h"
+#include "BoingReplay.h"
+#include "BoingScene.h"
+#include "BoingSim.h"
+
+// Heap allocations, counted the way the saver counts them. GCC flags the free() in the deletes
+// once the standard allocators inline them (it cannot see that new is malloc here).
+static std::atomic<uint64_t> g_allocations(0);
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// The saver's sizes
+const size_t   MAX_OUTPUTS = 32;
+const size_t   FRAME_ARENA_BYTES = 64 * 1024;
+const uint64_t HEAP_WARMUP_FRAMES = 120;
+const size_t   PARTICLE_JOB_CHUNK = 256;      // Smaller than the saver's so the jobs run at these counts
+const int      HOTPLUG_EVERY = 97;            // Frames between simulated display changes
+const float    FRAME_DT = 1.0f / 60.0f;
+
+// What the loop keeps per output, minus the window and context
+struct Output {
+    int         id = 0;
+    BallState   ball;
+    WorldBounds bounds;
+};
+
+static JobSystem    g_jobs;
+static ParticlePool g_particles;
+static FixedVector<Output, MAX_OUTPUTS> g_outputs;
+alignas(16) static unsigned char g_arenaStorage[FRAME_ARENA_BYTES];
+static FrameArena   g_arena(g_arenaStorage, FRAME_ARENA_BYTES);
+static int          g_failures = 0;
+static volatile float g_sink = 0.0f;          // Keeps the batch from being optimized away
+
+static void Check(bool ok, const char* what) {
+    if (ok) return;
+    ++g_failures;
+    std::printf("  FAILED: %s\n", what);
+}
+
+static Output MakeOutput(int id) {
+    Output out;
+    out.id = id;
+    out.bounds = SceneBoundsForSize(id % 2 ? 2560 : 1920, id % 2 ? 1440 : 1080);
+    out.ball.x = -0.5f + 0.1f * (float)(id % 8);
+    out.ball.vx = 0.8f + 0.05f * (float)id;
+    return out;
+}
+
+static void RunFrame(ReplayWriter& recorder) {
+    g_arena.Reset();
+    const SimParams params;
+    for (size_t o = 0; o < g_outputs.size(); ++o) {
+        Output& out = g_outputs[o];
+        SimImpacts impacts;
+        StepBall(out.ball, out.bounds, params, FRAME_DT * 0.5f, &impacts);
+        recorder.Impacts(o, impacts);
+        for (int i = 0; i < impacts.count; ++i) {
+            const SimImpact& h = impacts.list[i];
+            const bool floor = (h.event & SIM_EVENT_FLOOR) != 0;
+            g_particles.Emit(o, h.x, floor ? out.bounds.floorY : h.y, h.z, floor ? 0.0f : (h.x < 0.0f ? 1.0f : -1.0f),
+                floor ? 1.0f : 0.0f, 0.0f, floor ? 1.2f : 1.6f, out.bounds.floorY, 0x00B8C8D0, floor ? 48 : 32);
+        }
+    }
+    recorder.Tick(FRAME_DT * 0.5f);
+
+    const size_t live = g_particles.Live();
+    g_jobs.ParallelFor((live + PARTICLE_JOB_CHUNK - 1) / PARTICLE_JOB_CHUNK, 1, [live](size_t begin, size_t end) {
+        const size_t last = end * PARTICLE_JOB_CHUNK < live ? end * PARTICLE_JOB_CHUNK : live;
+        g_particles.Integrate(begin * PARTICLE_JOB_CHUNK, last, FRAME_DT * 0.5f, -9.8f);
+    });
+    g_particles.FinishUpdate();
+
+    for (const Output& out : g_outputs) {
+        BallBatch batch;
+        batch.begin(g_arena, BALL_BATCH_CAPACITY);
+        batch.add(out.ball.x, out.ball.y, out.ball.z, out.ball.spin, out.bounds.floorY);
+        for (size_t i = 0; i < batch.size(); ++i) g_sink = g_sink + batch.y[i];
+    }
+}
+
+// A monitor goes away and another appears: retire one output, bring up a new one at the end
+static void HotPlug(int& nextId) {
+    const size_t victim = (size_t)nextId % g_outputs.size();
+    const int after = victim + 1 < g_outputs.size() ? g_outputs[victim + 1].id : -1;
+    g_outputs.erase(g_outputs.begin() + victim);
+    if (after >= 0) Check(g_outputs[victim].id == after, "erase moves the next output down one slot");
+    Check(g_outputs.push_back(MakeOutput(nextId++)), "a freed slot takes a new output");
+    g_particles.Clear();   // World indices follow the output list, as in the saver
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int count = argc > 2 ? std::atoi(argv[2]) : 6;
+    const int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (frames <= (int)HEAP_WARMUP_FRAMES || count <= 0 || count > (int)MAX_OUTPUTS || threads < 0) {
+        std::fprintf(stderr, "usage: BoingAllocCheck [frames > %d] [outputs 1-%d] [threads]\n",
+            (int)HEAP_WARMUP_FRAMES, (int)MAX_OUTPUTS);
+        return 2;
+    }
+
+    if (threads) g_jobs.Start((unsigned)threads, (unsigned)threads);
+    else         g_jobs.Start();
+    int nextId = 0;
+    while ((int)g_outputs.size() < count) g_outputs.push_back(MakeOutput(nextId++));
+
+    ReplayWriter recorder;
+    std::FILE* fp = std::tmpfile();
+    Check(fp && recorder.Open(fp, SimParams(), SaverSettings()), "recording opens");
+    std::printf("BoingAllocCheck: %d frames, %d outputs, %u threads\n", frames, count, g_jobs.ThreadCount());
+
+    uint64_t steadyFrames = 0, allocFrames = 0, steadyAllocs = 0;
+    size_t peakParticles = 0;
+    for (int f = 0; f < frames; ++f) {
+        const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+        if (f > 0 && f % HOTPLUG_EVERY == 0) HotPlug(nextId);
+        RunFrame(recorder);
+        const uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - before;
+        if (g_particles.Live() > peakParticles) peakParticles = g_particles.Live();
+        if (f < (int)HEAP_WARMUP_FRAMES) continue;
+        ++steadyFrames;
+        if (allocs) { ++allocFrames; steadyAllocs += allocs; }
+    }
+    recorder.Close();
+
+    std::printf("  steady frames  %llu, %llu allocated (%llu allocations)\n", (unsigned long long)steadyFrames,
+        (unsigned long long)allocFrames, (unsigned long long)steadyAllocs);
+    std::printf("  frame arena    peak %zu of %zu bytes, %zu overflows; particles peak %zu\n",
+        g_arena.Peak(), g_arena.Capacity(), g_arena.Overflows(), peakParticles);
+    Check(allocFrames == 0, "steady-state frames make no heap allocations");
+    Check(g_arena.Overflows() == 0, "the frame arena never overflows");
+
+    g_jobs.Stop();
+    std::printf("  %s\n", g_failures ? "FAILED" : "all passed");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+// BoingAudioTool.cpp — encodes the bounce sounds to IMA ADPCM and benchmarks the saver's decoder
+// Portable C++17, no Windows headers. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingAudioTool.cpp -o BoingAudioTool
+//   ./BoingAudioTool encode sounds/BoingBallF.wav sounds/BoingBallF.ima.wav
+//   ./BoingAudioTool bench sounds/BoingBallF.wav sounds/BoingBallW.wav
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BoingAudio.h"
+
+static bool ReadFile(const char* path, std::vector<unsigned char>& out) {
+    std::FILE* fp = std::fopen(path, "rb");
+    if (!fp) return false;
+    std::fseek(fp, 0, SEEK_END);
+    long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && std::fread(out.data(), 1, out.size(), fp) == out.size();
+    std::fclose(fp);
+    return ok;
+}
+
+static bool WriteFile(const char* path, const std::vector<unsigned char>& data) {
+    std::FILE* fp = std::fopen(path, "wb");
+    if (!fp) return false;
+    bool ok = std::fwrite(data.data(), 1, data.size(), fp) == data.size();
+    std::fclose(fp);
+    return ok;
+}
+
+// Load a 16-bit PCM (or already compressed) WAVE file as interleaved samples
+static bool LoadPcm(const char* path, std::vector<unsigned char>& file, WaveInfo& info, std::vector<int16_t>& pcm) {
+    if (!ReadFile(path, file) || !ParseWave(file.data(), file.size(), info)) {
+        std::fprintf(stderr, "BoingAudioTool: %s is not a 16-bit PCM or IMA ADPCM WAVE file\n", path);
+        return false;
+    }
+    if (info.formatTag == WAVE_TAG_IMA_ADPCM) return ImaAdpcmDecode(info, pcm);
+    pcm.resize((size_t)info.frames * info.channels);
+    std::memcpy(pcm.data(), info.data, pcm.size() * sizeof(int16_t));
+    return true;
+}
+
+static int Encode(const char* in, const char* out) {
+    std::vector<unsigned char> file;
+    WaveInfo info;
+    std::vector<int16_t> pcm;
+    if (!LoadPcm(in, file, info, pcm)) return 1;
+
+    std::vector<unsigned char> ima;
+    BuildImaWave(pcm.data(), info.frames, info.channels, info.sampleRate, ima);
+    if (!WriteFile(out, ima)) {
+        std::fprintf(stderr, "BoingAudioTool: cannot write %s\n", out);
+        return 1;
+    }
+    std::printf("%s -> %s: %zu -> %zu bytes (%.1f%%)\n", in, out, file.size(), ima.size(),
+        100.0 * (double)ima.size() / (double)file.size());
+    return 0;
+}
+
+// Size, decode throughput and round-trip error for one file
+static int Bench(const char* path) {
+    std::vector<unsigned char> file;
+    WaveInfo info;
+    std::vector<int16_t> pcm;
+    if (!LoadPcm(path, file, info, pcm)) return 1;
+
+    std::vector<unsigned char> ima;
+    BuildImaWave(pcm.data(), info.frames, info.channels, info.sampleRate, ima);
+    WaveInfo imaInfo;
+    ParseWave(ima.data(), ima.size(), imaInfo);
+
+    // Decode repeatedly into the same buffer for at least half a second
+    std::vector<int16_t> decoded;
+    auto t0 = std::chrono::steady_clock::now();
+    int runs = 0;
+    double seconds = 0.0;
+    do {
+        ImaAdpcmDecode(imaInfo, decoded);
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (seconds < 0.5);
+
+    // Full runtime path once (decode plus building the playable RIFF image)
+    std::vector<unsigned char> riff;
+    auto t1 = std::chrono::steady_clock::now();
+    DecodeToPcmWave(ima.data(), ima.size(), riff);
+    double riffMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t1).count();
+
+    double signal = 0.0, noise = 0.0;
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        double d = (double)pcm[i] - (double)decoded[i];
+        signal += (double)pcm[i] * (double)pcm[i];
+        noise += d * d;
+    }
+    double snr = (noise > 0.0) ? 10.0 * std::log10(signal / noise) : 99.0;
+
+    double perRun = seconds / runs;
+    double audioSeconds = (double)info.frames / (double)info.sampleRate;
+    std::printf("%s\n", path);
+    std::printf("  format      %u Hz, %u ch, %u frames (%.2f s)\n", info.sampleRate, info.channels, info.frames, audioSeconds);
+    std::printf("  size        PCM %zu bytes, IMA ADPCM %zu bytes (%.1f%%)\n", file.size(), ima.size(),
+        100.0 * (double)ima.size() / (double)file.size());
+    std::printf("  decode      %.3f ms per file, %.1f Msamples/s, %.0fx real time (%d runs)\n", perRun * 1000.0,
+        (double)pcm.size() / perRun / 1e6, audioSeconds / perRun, runs);
+    std::printf("  to RIFF     %.3f ms (decode + playable PCM image)\n", riffMs);
+    std::printf("  round trip  SNR %.1f dB\n", snr);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 4 && std::strcmp(argv[1], "encode") == 0) return Encode(argv[2], argv[3]);
+    if (argc >= 3 && std::strcmp(argv[1], "bench") == 0) {
+        int rc = 0;
+        for (int i = 2; i < argc; ++i) rc |= Bench(argv[i]);
+        return rc;
+    }
+    std::fprintf(stderr, "usage: BoingAudioTool encode in.wav out.ima.wav\n"
+        "       BoingAudioTool bench file.wav [file.wav ...]\n");
+    return 2;
+}
@@ -0,0 +1,184 @@
+// BoingFrameExport.cpp — sample consumer for the frame export ring (src/BoingExport.h), plus a
+// synthetic producer so the ring can be exercised and timed without the saver
+// POSIX (Linux): uses shm_open and CLOCK_MONOTONIC, the clock the ring's timestamps use here.
+// Build from the repository root, e.g.:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingFrameExport.cpp -o BoingFrameExport -lrt
+//   ./BoingFrameExport produce [seconds] [width] [height] [fps] [slots]   (writes /BoingBallSaverFrames0)
+//   ./BoingFrameExport consume [seconds] [output]                        (reads  /BoingBallSaverFrames<output>)
+// The consumer reads every frame in place, checks it was not overwritten while being read, and
+// reports capture-to-consumer and publish-to-consumer latency.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "BoingExport.h"
+
+static uint64_t NowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static std::string RingName(int output) {
+    return std::string("/") + EXPORT_RING_NAME + std::to_string(output);
+}
+
+// A moving gradient with a frame counter baked into the first pixel, filled row by row the way a
+// readback would
+static void DrawTestFrame(unsigned char* pixels, uint32_t w, uint32_t h, uint32_t stride, uint64_t frame) {
+    for (uint32_t y = 0; y < h; ++y) {
+        uint32_t* row = (uint32_t*)(pixels + (size_t)y * stride);
+        const uint32_t g = (uint32_t)((y + frame) & 0xFF) << 8;
+        for (uint32_t x = 0; x < w; ++x) row[x] = 0xFF000000u | ((uint32_t)((x + frame) & 0xFF) << 16) | g | 0x40u;
+    }
+    std::memcpy(pixels, &frame, sizeof(uint32_t));
+}
+
+static int Produce(double seconds, uint32_t w, uint32_t h, double fps, uint32_t slots) {
+    const std::string name = RingName(0);
+    const uint32_t stride = w * 4;
+    const uint64_t bytes = ExportRingBytes(slots, (uint64_t)stride * h);
+
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)bytes) != 0) {
+        std::fprintf(stderr, "BoingFrameExport: cannot create %s\n", name.c_str());
+        return 1;
+    }
+    void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ExportRingWriter writer;
+    if (base == MAP_FAILED || !writer.Attach(base, bytes, slots, (uint64_t)stride * h, (uint32_t)getpid())) {
+        std::fprintf(stderr, "BoingFrameExport: cannot map %s\n", name.c_str());
+        return 1;
+    }
+
+    std::printf("producing %s: %ux%u BGRA, %u slots (%.1f MB), %.0f fps for %.0f s\n", name.c_str(), w, h, slots,
+        (double)bytes / (1024.0 * 1024.0), fps, seconds);
+    const uint64_t period = (uint64_t)(1e9 / fps);
+    const uint64_t start = NowNs(), end = start + (uint64_t)(seconds * 1e9);
+    uint64_t next = start, fillNs = 0;
+    while (NowNs() < end) {
+        const uint64_t capture = NowNs();
+        unsigned char* pixels = writer.BeginFrame(w, h, stride, EXPORT_FORMAT_BGRA8, 0, capture);
+        DrawTestFrame(pixels, w, h, stride, writer.Frames() + 1);
+        const uint64_t done = NowNs();
+        writer.Publish(done);
+        fillNs += done - capture;
+        next += period;
+        const uint64_t now = NowNs();
+        if (next > now) std::this_thread::sleep_for(std::chrono::nanoseconds(next - now));
+        else next = now;
+    }
+    std::printf("  %llu frames, %.2f ms per frame to fill a slot\n", (unsigned long long)writer.Frames(),
+        writer.Frames() ? (double)fillNs / (double)writer.Frames() / 1e6 : 0.0);
+
+    munmap(base, bytes);
+    shm_unlink(name.c_str());
+    return 0;
+}
+
+static double Percentile(std::vector<uint64_t>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t i = (size_t)(p * (double)(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + i, v.end());
+    return (double)v[i] / 1e3;
+}
+
+static int Consume(double seconds, int output) {
+    const std::string name = RingName(output);
+    int fd = -1;
+    const uint64_t waitUntil = NowNs() + 10000000000ull;    // The producer may still be starting
+    while ((fd = shm_open(name.c_str(), O_RDONLY, 0)) < 0 && NowNs() < waitUntil) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        std::fprintf(stderr, "BoingFrameExport: %s not found (is the producer running?)\n", name.c_str());
+        return 1;
+    }
+    const uint64_t bytes = (uint64_t)st.st_size;
+    void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ExportRingReader reader;
+    if (base == MAP_FAILED || !reader.Attach(base, bytes)) {
+        std::fprintf(stderr, "BoingFrameExport: %s is not a frame export ring\n", name.c_str());
+        return 1;
+    }
+    std::printf("consuming %s from pid %u for %.0f s\n", name.c_str(), reader.ProducerPid(), seconds);
+
+    std::vector<uint64_t> fromCapture, fromPublish;
+    fromCapture.reserve(1 << 16);
+    fromPublish.reserve(1 << 16);
+    uint64_t last = 0, seen = 0, missed = 0, torn = 0, lapped = 0, badPixels = 0, checksum = 0;
+    uint32_t width = 0, height = 0;
+    const uint64_t end = NowNs() + (uint64_t)(seconds * 1e9);
+    while (NowNs() < end) {
+        ExportFrameView view;
+        if (!reader.Acquire(last, view)) {
+            if (reader.Latest() > last) ++lapped;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        const uint64_t now = NowNs();
+
+        // Use the pixels in place: a sparse checksum and the frame number in the first pixel
+        uint32_t stamp = 0;
+        std::memcpy(&stamp, view.pixels, sizeof(stamp));
+        for (uint32_t y = 0; y < view.height; y += 64) checksum += view.pixels[(size_t)y * view.stride + 4];
+        if (!reader.StillValid(view)) { ++torn; continue; }
+
+        if (stamp != (uint32_t)view.frame) ++badPixels;
+        if (last && view.frame > last + 1) missed += view.frame - last - 1;
+        last = view.frame;
+        ++seen;
+        width = view.width;
+        height = view.height;
+        fromCapture.push_back(now - view.captureNs);
+        fromPublish.push_back(now - view.publishNs);
+    }
+
+    std::printf("  %llu frames of %ux%u, %llu skipped (not polled in time), %llu torn, %llu lapped, %llu bad\n",
+        (unsigned long long)seen, width, height, (unsigned long long)missed, (unsigned long long)torn,
+        (unsigned long long)lapped, (unsigned long long)badPixels);
+    std::printf("  capture -> consumer  p50 %.0f us, p99 %.0f us, max %.0f us\n", Percentile(fromCapture, 0.5),
+        Percentile(fromCapture, 0.99), Percentile(fromCapture, 1.0));
+    std::printf("  publish -> consumer  p50 %.0f us, p99 %.0f us, max %.0f us\n", Percentile(fromPublish, 0.5),
+        Percentile(fromPublish, 0.99), Percentile(fromPublish, 1.0));
+    if (checksum == 1) std::printf(" ");    // Keep the pixel reads
+    munmap(base, bytes);
+    return badPixels ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "produce") == 0) {
+        double seconds = argc > 2 ? std::atof(argv[2]) : 10.0;
+        uint32_t w = argc > 3 ? (uint32_t)std::atoi(argv[3]) : 1920;
+        uint32_t h = argc > 4 ? (uint32_t)std::atoi(argv[4]) : 1080;
+        double fps = argc > 5 ? std::atof(argv[5]) : 60.0;
+        uint32_t slots = argc > 6 ? (uint32_t)std::atoi(argv[6]) : EXPORT_DEFAULT_SLOTS;
+        if (seconds > 0.0 && w > 0 && h > 0 && fps > 0.0 && slots >= EXPORT_MIN_SLOTS && slots <= EXPORT_MAX_SLOTS) {
+            return Produce(seconds, w, h, fps, slots);
+        }
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "consume") == 0) {
+        double seconds = argc > 2 ? std::atof(argv[2]) : 10.0;
+        int output = argc > 3 ? std::atoi(argv[3]) : 0;
+        if (seconds > 0.0 && output >= 0) return Consume(seconds, output);
+    }
+    std::fprintf(stderr, "usage: BoingFrameExport produce [seconds] [width] [height] [fps] [slots]\n"
+        "       BoingFrameExport consume [seconds] [output]\n");
+    return 2;
+}
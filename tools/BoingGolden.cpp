@@ -0,0 +1,954 @@
+// BoingGolden.cpp — golden-image and frame-time regression harness
+// Renders a fixed set of scenarios with a CPU reference renderer (no GPU, window or GL needed) from
+// the same scene description the saver draws (BoingScene.h), meshes and checker mips
+// (BoingAssets.h) and simulation (BoingSim.h), then compares every frame with a stored golden image
+// under a perceptual tolerance and checks render time and heap allocations against a baseline.
+// Portable C++17. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -ffp-contract=off -pthread -Isrc tools/BoingGolden.cpp -o BoingGolden
+//   ./BoingGolden check [golden-dir] [threads]      (exit 1 on image drift, slowdown or new allocations)
+//   ./BoingGolden update [golden-dir] [threads]     (rewrite the golden images and the baseline)
+//   ./BoingGolden baseline [golden-dir] [threads]   (re-time on this machine, images untouched)
+//   ./BoingGolden render <scenario> <out.ppm>
+// golden-dir defaults to tools/golden. A failed check leaves <scenario>.actual.ppm and
+// <scenario>.diff.ppm in the working directory.
+// Built with -DBOING_GOLDEN_CORE_GL=1 and -lEGL, a last argument of core (or core-staged, which
+// avoids the persistent-mapped buffer) checks the saver's core-profile renderer (BoingCoreGL.h)
+// instead, on a headless EGL context such as Mesa's llvmpipe, against golden-dir/core:
+//   g++ -std=c++17 -O2 -ffp-contract=off -pthread -DBOING_GOLDEN_CORE_GL=1 -Isrc tools/BoingGolden.cpp -o BoingGolden -lEGL
+//   ./BoingGolden check tools/golden 1 core
+//   ./BoingGolden render classic classic.ppm core
+//
+// The reference renderer follows the GL 1.1 fixed-function rules the saver relies on: per-vertex
+// lighting with GL's default material, perspective-correct texturing with GL_MODULATE, trilinear
+// filtering (LOD chosen per triangle), depth test GL_LESS, SRC_ALPHA blending and the top-left fill
+// rule. Grid lines are drawn untextured in SCENE_GRID_COLOR. Particles and the impostor are not
+// rendered (the first is random, the second a capture of the sphere drawn here).
+// Balls go through a BallBatch (BoingScene.h) in the saver's grouped pass order; the batch scenario
+// fills it with several balls at different depths. The saver's own GL 1.1 calls (display lists on
+// a WGL context) are not run here: the reference renderer stands in for them.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BoingAssets.h"
+#include "BoingJobs.h"
+#include "BoingScene.h"
+#include "BoingSim.h"
+
+#if BOING_GOLDEN_CORE_GL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include "BoingCoreGL.h"
+#endif
+
+// Heap allocations, counted the way the saver counts them: a frame must not allocate once warm.
+// Every form is replaced so new and delete always pair up; GCC still flags the free() in the
+// deletes once the standard allocators inline them (it cannot see that new is malloc here).
+static std::atomic<uint64_t> g_allocations(0);
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Tolerances
+const float  GOLDEN_JND = 2.3f;               // CIE76 delta E a viewer can just notice
+const double GOLDEN_MAX_OVER_JND = 0.001;     // Fraction of pixels allowed past the JND
+const double GOLDEN_MAX_MEAN_DE = 0.25;       // Mean delta E over the whole frame
+const double GOLDEN_MAX_SLOWDOWN = 1.5;       // Best frame time against the baseline...
+const double GOLDEN_MIN_SLOWDOWN_MS = 0.5;    // ...ignoring differences below this
+const int    GOLDEN_WARMUP_FRAMES = 3;
+const int    GOLDEN_TIMED_FRAMES = 31;
+const float  GOLDEN_DT = 1.0f / 60.0f;
+const int    GOLDEN_TILE = 32;
+
+struct Scenario {
+    const char* name;
+    int      width, height;
+    int      ticks;            // Simulation steps of GOLDEN_DT from the start state before the frame
+    int      geometry;         // Settings geometry mode: 0 = smooth, 1 = classic
+    bool     floorShadow, wallShadow, grid, lighting;
+    uint32_t bgColor;          // 0x00BBGGRR
+    int      balls = 1;        // Balls in the frame's batch, each from its own start state
+};
+
+static const Scenario g_scenarios[] = {
+    { "classic",  320, 240,  70, 1, true,  true,  true,  true,  0x00C0C0C0u },
+    { "smooth",   320, 240, 130, 0, true,  true,  true,  true,  0x00C0C0C0u },
+    { "unlit",    320, 240, 200, 1, false, false, true,  false, 0x00402010u },
+    { "wide",     480, 160, 290, 0, true,  true,  true,  true,  0x00C0C0C0u },
+    { "noshadow", 200, 200,  75, 0, false, false, false, true,  0x00FFFFFFu },
+    { "batch",    320, 240, 110, 1, true,  true,  true,  true,  0x00C0C0C0u, 6 },
+};
+
+// Backing for each frame's ball batch, as the saver's frame arena backs its own
+alignas(16) static unsigned char g_arenaStorage[4096];
+static FrameArena g_arena(g_arenaStorage, sizeof(g_arenaStorage));
+
+// Reference renderer
+// Geometry is transformed once per frame into screen-space triangles; the frame is then rasterized
+// tile by tile on the job system, every tile walking the whole list in submission order, so the
+// image does not depend on the thread count.
+const size_t REF_MAX_TRIANGLES = 16384;
+const size_t REF_MAX_VERTICES = 4096;
+
+struct RefTriangle {
+    float x[3], y[3], z[3];      // Window coordinates (y down), depth in [0, 1]
+    float iw[3];                 // 1 / clip w, for perspective-correct attributes
+    float r[3], g[3], b[3], a[3];
+    float s[3], t[3];
+    float minX, minY, maxX, maxY;
+    float lod;                   // Mip level (fractional), for textured triangles
+    bool  textured, depthWrite;
+};
+
+struct RefVertex {
+    float x, y, z, iw;
+    float r, g, b, a;
+    float s, t;
+};
+
+class RefRenderer {
+public:
+    void Init(const SharedAssets& assets, int width, int height) {
+        assets_ = &assets;
+        width_ = width;
+        height_ = height;
+        color_.assign((size_t)width * height * 3, 0.0f);
+        depth_.assign((size_t)width * height, 1.0f);
+        tris_.resize(REF_MAX_TRIANGLES);
+        verts_.resize(REF_MAX_VERTICES);
+        ScenePerspective(proj_, (float)width / (float)height);
+    }
+
+    void Begin(uint32_t bgColor) {
+        clear_[0] = (float)(bgColor & 0xFF) / 255.0f;
+        clear_[1] = (float)((bgColor >> 8) & 0xFF) / 255.0f;
+        clear_[2] = (float)((bgColor >> 16) & 0xFF) / 255.0f;
+        triCount_ = 0;
+    }
+
+    // A mesh under a column-major modelview; lit meshes take GL's lighting equation, the rest the flat color
+    void AddMesh(const SphereMeshView& mesh, const float mv[16], bool lit, const float rgba[4], bool textured) {
+        if (mesh.vertexCount > REF_MAX_VERTICES) return;
+        float l[3] = { SCENE_LIGHT_DIR[0], SCENE_LIGHT_DIR[1], SCENE_LIGHT_DIR[2] };
+        const float ll = std::sqrt(l[0] * l[0] + l[1] * l[1] + l[2] * l[2]);
+        for (float& c : l) c /= ll;
+
+        for (uint32_t i = 0; i < mesh.vertexCount; ++i) {
+            const float* p = mesh.positions + i * 3;
+            float eye[4];
+            Transform(mv, p[0], p[1], p[2], 1.0f, eye);
+            RefVertex& v = verts_[i];
+            Project(eye, v);
+            v.s = mesh.texcoords[i * 2];
+            v.t = mesh.texcoords[i * 2 + 1];
+            if (lit) {
+                const float* n = mesh.normals + i * 3;
+                float ne[4];
+                Transform(mv, n[0], n[1], n[2], 0.0f, ne);
+                float d = ne[0] * l[0] + ne[1] * l[1] + ne[2] * l[2];
+                if (d < 0.0f) d = 0.0f;
+                float c[3];
+                for (int k = 0; k < 3; ++k) {
+                    c[k] = SCENE_MATERIAL_AMBIENT[k] * (SCENE_GLOBAL_AMBIENT[k] + SCENE_LIGHT_AMBIENT[k]) +
+                        d * SCENE_MATERIAL_DIFFUSE[k] * SCENE_LIGHT_DIFFUSE[k];
+                    c[k] = c[k] > 1.0f ? 1.0f : c[k];
+                }
+                v.r = c[0]; v.g = c[1]; v.b = c[2]; v.a = SCENE_MATERIAL_DIFFUSE[3];
+            }
+            else {
+                v.r = rgba[0]; v.g = rgba[1]; v.b = rgba[2]; v.a = rgba[3];
+            }
+        }
+        for (uint32_t i = 0; i + 2 < mesh.indexCount; i += 3) {
+            const RefVertex* tri[3] = { &verts_[mesh.indices[i]], &verts_[mesh.indices[i + 1]], &verts_[mesh.indices[i + 2]] };
+            AddTriangle(tri, textured, true);
+        }
+    }
+
+    // A world-space line under the camera transform, rasterized like a GL wide line: a
+    // parallelogram spread along the minor axis
+    void AddLine(const float a[3], const float b[3], float width, const float rgb[3]) {
+        float ea[4] = { a[0], a[1], a[2] - SCENE_CAMERA_Z, 1.0f }, eb[4] = { b[0], b[1], b[2] - SCENE_CAMERA_Z, 1.0f };
+        RefVertex va, vb;
+        if (!Project(ea, va) || !Project(eb, vb)) return;
+        const bool xMajor = std::fabs(vb.x - va.x) >= std::fabs(vb.y - va.y);
+        const float ox = xMajor ? 0.0f : width * 0.5f, oy = xMajor ? width * 0.5f : 0.0f;
+        RefVertex q[4] = { va, va, vb, vb };
+        q[0].x -= ox; q[0].y -= oy; q[1].x += ox; q[1].y += oy;
+        q[2].x -= ox; q[2].y -= oy; q[3].x += ox; q[3].y += oy;
+        for (RefVertex& v : q) { v.r = rgb[0]; v.g = rgb[1]; v.b = rgb[2]; v.a = 1.0f; v.s = v.t = 0.0f; }
+        const RefVertex* t0[3] = { &q[0], &q[1], &q[2] };
+        const RefVertex* t1[3] = { &q[2], &q[1], &q[3] };
+        AddTriangle(t0, false, true);
+        AddTriangle(t1, false, true);
+    }
+
+    void Render(JobSystem& jobs) {
+        jobs.ParallelForTiles(width_, height_, GOLDEN_TILE, [this](int x0, int y0, int x1, int y1) {
+            RasterTile(x0, y0, x1, y1);
+        });
+    }
+
+    // 8-bit RGB, top row first
+    void Resolve(std::vector<unsigned char>& rgb) const {
+        rgb.resize(color_.size());
+        for (size_t i = 0; i < color_.size(); ++i) {
+            float c = color_[i] < 0.0f ? 0.0f : (color_[i] > 1.0f ? 1.0f : color_[i]);
+            rgb[i] = (unsigned char)(c * 255.0f + 0.5f);
+        }
+    }
+
+    size_t Triangles() const { return triCount_; }
+
+private:
+    static void Transform(const float m[16], float x, float y, float z, float w, float out[4]) {
+        for (int r = 0; r < 4; ++r) out[r] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r] * w;
+    }
+
+    // Eye space to window coordinates; false behind the near plane (nothing in the scene gets there)
+    bool Project(const float eye[4], RefVertex& v) const {
+        float clip[4];
+        Transform(proj_, eye[0], eye[1], eye[2], eye[3], clip);
+        if (clip[3] < SCENE_NEAR) { v.iw = 0.0f; return false; }
+        v.iw = 1.0f / clip[3];
+        v.x = (clip[0] * v.iw * 0.5f + 0.5f) * (float)width_;
+        v.y = (0.5f - clip[1] * v.iw * 0.5f) * (float)height_;
+        v.z = clip[2] * v.iw * 0.5f + 0.5f;
+        return true;
+    }
+
+    void AddTriangle(const RefVertex* v[3], bool textured, bool depthWrite) {
+        if (triCount_ == tris_.size()) return;
+        if (v[0]->iw == 0.0f || v[1]->iw == 0.0f || v[2]->iw == 0.0f) return;
+        float area = (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) - (v[1]->y - v[0]->y) * (v[2]->x - v[0]->x);
+        if (area == 0.0f) return;
+        if (area < 0.0f) { std::swap(v[1], v[2]); area = -area; }    // No culling: both windings fill
+
+        RefTriangle& t = tris_[triCount_];
+        for (int k = 0; k < 3; ++k) {
+            t.x[k] = v[k]->x; t.y[k] = v[k]->y; t.z[k] = v[k]->z; t.iw[k] = v[k]->iw;
+            t.r[k] = v[k]->r; t.g[k] = v[k]->g; t.b[k] = v[k]->b; t.a[k] = v[k]->a;
+            t.s[k] = v[k]->s; t.t[k] = v[k]->t;
+        }
+        t.minX = std::min(t.x[0], std::min(t.x[1], t.x[2]));
+        t.maxX = std::max(t.x[0], std::max(t.x[1], t.x[2]));
+        t.minY = std::min(t.y[0], std::min(t.y[1], t.y[2]));
+        t.maxY = std::max(t.y[0], std::max(t.y[1], t.y[2]));
+        if (t.maxX < 0.0f || t.maxY < 0.0f || t.minX > (float)width_ || t.minY > (float)height_) return;
+        t.textured = textured;
+        t.depthWrite = depthWrite;
+        t.lod = 0.0f;
+        if (textured) {
+            // Texel area over pixel area gives rho squared; lambda = log2(rho)
+            const TextureMip& base = assets_->checkerMips[0];
+            float texArea = std::fabs((t.s[1] - t.s[0]) * (t.t[2] - t.t[0]) - (t.t[1] - t.t[0]) * (t.s[2] - t.s[0])) *
+                (float)base.width * (float)base.height;
+            float lod = texArea > 0.0f ? 0.5f * std::log2(texArea / area) : 0.0f;
+            float maxLod = (float)(assets_->checkerLevels - 1);
+            t.lod = lod < 0.0f ? 0.0f : (lod > maxLod ? maxLod : lod);
+        }
+        ++triCount_;
+    }
+
+    // Bilinear fetch from one mip level, clamp to edge
+    void SampleLevel(int level, float s, float t, float out[3]) const {
+        const TextureMip& mip = assets_->checkerMips[level];
+        const unsigned char* texels = assets_->checkerTexels + mip.offset;
+        float u = s * (float)mip.width - 0.5f, v = t * (float)mip.height - 0.5f;
+        int u0 = (int)std::floor(u), v0 = (int)std::floor(v);
+        float fu = u - (float)u0, fv = v - (float)v0;
+        int u1 = u0 + 1, v1 = v0 + 1;
+        u0 = std::clamp(u0, 0, mip.width - 1); u1 = std::clamp(u1, 0, mip.width - 1);
+        v0 = std::clamp(v0, 0, mip.height - 1); v1 = std::clamp(v1, 0, mip.height - 1);
+        const unsigned char* p00 = texels + ((size_t)v0 * mip.width + u0) * 3;
+        const unsigned char* p10 = texels + ((size_t)v0 * mip.width + u1) * 3;
+        const unsigned char* p01 = texels + ((size_t)v1 * mip.width + u0) * 3;
+        const unsigned char* p11 = texels + ((size_t)v1 * mip.width + u1) * 3;
+        for (int k = 0; k < 3; ++k) {
+            float top = p00[k] + (p10[k] - p00[k]) * fu;
+            float bottom = p01[k] + (p11[k] - p01[k]) * fu;
+            out[k] = (top + (bottom - top) * fv) * (1.0f / 255.0f);
+        }
+    }
+
+    void Sample(float lod, float s, float t, float out[3]) const {
+        const int l0 = (int)lod;
+        SampleLevel(l0, s, t, out);
+        const float f = lod - (float)l0;
+        if (f <= 0.0f || l0 + 1 >= assets_->checkerLevels) return;
+        float next[3];
+        SampleLevel(l0 + 1, s, t, next);
+        for (int k = 0; k < 3; ++k) out[k] += (next[k] - out[k]) * f;
+    }
+
+    // Edge (a -> b) owns the pixels exactly on it when it is a top or a left edge (y down)
+    static bool TopLeft(float ax, float ay, float bx, float by) {
+        return (by == ay && bx > ax) || by < ay;
+    }
+
+    void RasterTile(int x0, int y0, int x1, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            float* c = &color_[((size_t)y * width_ + x0) * 3];
+            float* d = &depth_[(size_t)y * width_ + x0];
+            for (int x = x0; x < x1; ++x, c += 3, ++d) {
+                c[0] = clear_[0]; c[1] = clear_[1]; c[2] = clear_[2];
+                *d = 1.0f;
+            }
+        }
+
+        for (size_t i = 0; i < triCount_; ++i) {
+            const RefTriangle& t = tris_[i];
+            int bx0 = std::max(x0, (int)std::floor(t.minX - 0.5f));
+            int bx1 = std::min(x1 - 1, (int)std::ceil(t.maxX - 0.5f));
+            int by0 = std::max(y0, (int)std::floor(t.minY - 0.5f));
+            int by1 = std::min(y1 - 1, (int)std::ceil(t.maxY - 0.5f));
+            if (bx0 > bx1 || by0 > by1) continue;
+
+            const float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+            const float invArea = 1.0f / area;
+            const bool own0 = TopLeft(t.x[1], t.y[1], t.x[2], t.y[2]);
+            const bool own1 = TopLeft(t.x[2], t.y[2], t.x[0], t.y[0]);
+            const bool own2 = TopLeft(t.x[0], t.y[0], t.x[1], t.y[1]);
+
+            for (int y = by0; y <= by1; ++y) {
+                const float py = (float)y + 0.5f;
+                for (int x = bx0; x <= bx1; ++x) {
+                    const float px = (float)x + 0.5f;
+                    float e0 = (t.x[2] - t.x[1]) * (py - t.y[1]) - (t.y[2] - t.y[1]) * (px - t.x[1]);
+                    float e1 = (t.x[0] - t.x[2]) * (py - t.y[2]) - (t.y[0] - t.y[2]) * (px - t.x[2]);
+                    float e2 = (t.x[1] - t.x[0]) * (py - t.y[0]) - (t.y[1] - t.y[0]) * (px - t.x[0]);
+                    if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f) continue;
+                    if ((e0 == 0.0f && !own0) || (e1 == 0.0f && !own1) || (e2 == 0.0f && !own2)) continue;
+
+                    const float l0 = e0 * invArea, l1 = e1 * invArea, l2 = e2 * invArea;
+                    const size_t p = (size_t)y * width_ + x;
+                    const float z = l0 * t.z[0] + l1 * t.z[1] + l2 * t.z[2];
+                    if (!(z < depth_[p])) continue;
+                    if (t.depthWrite) depth_[p] = z;
+
+                    // Perspective-correct weights
+                    const float w0 = l0 * t.iw[0], w1 = l1 * t.iw[1], w2 = l2 * t.iw[2];
+                    const float inv = 1.0f / (w0 + w1 + w2);
+                    float src[3] = {
+                        (w0 * t.r[0] + w1 * t.r[1] + w2 * t.r[2]) * inv,
+                        (w0 * t.g[0] + w1 * t.g[1] + w2 * t.g[2]) * inv,
+                        (w0 * t.b[0] + w1 * t.b[1] + w2 * t.b[2]) * inv
+                    };
+                    const float alpha = (w0 * t.a[0] + w1 * t.a[1] + w2 * t.a[2]) * inv;
+                    if (t.textured) {
+                        float tex[3];
+                        Sample(t.lod, (w0 * t.s[0] + w1 * t.s[1] + w2 * t.s[2]) * inv,
+                            (w0 * t.t[0] + w1 * t.t[1] + w2 * t.t[2]) * inv, tex);
+                        src[0] *= tex[0]; src[1] *= tex[1]; src[2] *= tex[2];
+                    }
+                    float* dst = &color_[p * 3];
+                    for (int k = 0; k < 3; ++k) dst[k] = src[k] * alpha + dst[k] * (1.0f - alpha);
+                }
+            }
+        }
+    }
+
+    const SharedAssets*      assets_ = nullptr;
+    int                      width_ = 0, height_ = 0;
+    float                    proj_[16] = {};
+    float                    clear_[3] = {};
+    std::vector<float>       color_;
+    std::vector<float>       depth_;
+    std::vector<RefTriangle> tris_;
+    std::vector<RefVertex>   verts_;
+    size_t                   triCount_ = 0;
+};
+
+// One frame of a scenario, in the saver's drawing order: grid, then the batch's floor shadows, wall
+// shadows and balls
+static void BuildFrame(RefRenderer& ref, const SharedAssets& assets, const Scenario& sc, const BallBatch& batch,
+    const WorldBounds& bounds) {
+    ref.Begin(sc.bgColor);
+    if (sc.grid) {
+        ForEachGridLine(bounds.floorY, [&ref](float x0, float y0, float z0, float x1, float y1, float z1) {
+            const float a[3] = { x0, y0, z0 }, b[3] = { x1, y1, z1 };
+            ref.AddLine(a, b, SCENE_GRID_LINE_WIDTH, SCENE_GRID_COLOR);
+        });
+    }
+
+    const SphereMeshView& mesh = assets.sphere[sc.geometry == 1 ? 1 : 0];
+    float m[16];
+    const size_t n = batch.size();
+    if (sc.floorShadow) {
+        const float shadow[4] = { 0.0f, 0.0f, 0.0f, SCENE_FLOOR_SHADOW_ALPHA };
+        for (size_t i = 0; i < n; ++i) {
+            SceneFloorShadowMatrix(m, batch.x[i], batch.floorY[i], batch.z[i]);
+            ref.AddMesh(mesh, m, false, shadow, false);     // Black modulated by the texture is still black
+        }
+    }
+    if (sc.wallShadow) {
+        const float shadow[4] = { 0.0f, 0.0f, 0.0f, SCENE_WALL_SHADOW_ALPHA };
+        for (size_t i = 0; i < n; ++i) {
+            SceneWallShadowMatrix(m, batch.x[i], batch.y[i]);
+            ref.AddMesh(mesh, m, false, shadow, false);
+        }
+    }
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (size_t i = 0; i < n; ++i) {
+        SceneBallMatrix(m, batch.x[i], batch.y[i], batch.z[i], batch.spin[i]);
+        ref.AddMesh(mesh, m, sc.lighting, white, true);
+    }
+}
+
+// Run every ball of a scenario to its frame and gather them into a batch on g_arena. The first ball
+// starts from the saver's start state; the others are spread across the view and in depth.
+static void SimulateScenario(const Scenario& sc, WorldBounds& bounds, BallBatch& batch) {
+    bounds = SceneBoundsForSize(sc.width, sc.height);
+    SimParams params;
+    params.radius = ASSET_BALL_RADIUS;
+    g_arena.Reset();
+    batch.begin(g_arena, BALL_BATCH_CAPACITY);
+    for (int b = 0; b < sc.balls; ++b) {
+        BallState ball;
+        if (b > 0) {
+            ball.x = -0.75f + 0.3f * (float)b;
+            ball.z = 0.3f * (float)(b % 3 - 1);
+            ball.vx = (b & 1) ? -0.6f - 0.1f * (float)b : 0.6f + 0.1f * (float)b;
+            ball.vy = 3.0f + 0.4f * (float)b;
+            ball.spin = 30.0f * (float)b;
+        }
+        for (int i = 0; i < sc.ticks; ++i) StepBall(ball, bounds, params, GOLDEN_DT);
+        batch.add(ball.x, ball.y, ball.z, ball.spin, bounds.floorY);
+    }
+}
+
+// Images: binary PPM (P6), 8-bit RGB, top row first
+static bool WritePpm(const std::string& path, int w, int h, const std::vector<unsigned char>& rgb) {
+    std::FILE* fp = std::fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    std::fprintf(fp, "P6\n%d %d\n255\n", w, h);
+    bool ok = std::fwrite(rgb.data(), 1, rgb.size(), fp) == rgb.size();
+    return std::fclose(fp) == 0 && ok;
+}
+
+static bool ReadPpm(const std::string& path, int& w, int& h, std::vector<unsigned char>& rgb) {
+    std::FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    int maxValue = 0;
+    bool ok = std::fscanf(fp, "P6 %d %d %d", &w, &h, &maxValue) == 3 && maxValue == 255 && w > 0 && h > 0 &&
+        std::fgetc(fp) != EOF;
+    if (ok) {
+        rgb.resize((size_t)w * h * 3);
+        ok = std::fread(rgb.data(), 1, rgb.size(), fp) == rgb.size();
+    }
+    std::fclose(fp);
+    return ok;
+}
+
+// Perceptual difference: sRGB to CIELAB (D65), delta E 1976
+static void SrgbToLab(const unsigned char* c, float lab[3]) {
+    float lin[3];
+    for (int k = 0; k < 3; ++k) {
+        float v = (float)c[k] / 255.0f;
+        lin[k] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+    }
+    float xyz[3] = {
+        (0.4124f * lin[0] + 0.3576f * lin[1] + 0.1805f * lin[2]) / 0.95047f,
+        (0.2126f * lin[0] + 0.7152f * lin[1] + 0.0722f * lin[2]),
+        (0.0193f * lin[0] + 0.1192f * lin[1] + 0.9505f * lin[2]) / 1.08883f
+    };
+    for (float& v : xyz) v = v > 0.008856f ? std::cbrt(v) : 7.787f * v + 16.0f / 116.0f;
+    lab[0] = 116.0f * xyz[1] - 16.0f;
+    lab[1] = 500.0f * (xyz[0] - xyz[1]);
+    lab[2] = 200.0f * (xyz[1] - xyz[2]);
+}
+
+struct ImageDiff {
+    double meanDE = 0.0, maxDE = 0.0;
+    size_t overJnd = 0, pixels = 0;
+};
+
+static ImageDiff CompareImages(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b,
+    std::vector<unsigned char>* diffImage) {
+    ImageDiff d;
+    d.pixels = a.size() / 3;
+    if (diffImage) diffImage->resize(a.size());
+    double sum = 0.0;
+    for (size_t i = 0; i < d.pixels; ++i) {
+        float la[3], lb[3];
+        SrgbToLab(&a[i * 3], la);
+        SrgbToLab(&b[i * 3], lb);
+        const float de = std::sqrt((la[0] - lb[0]) * (la[0] - lb[0]) + (la[1] - lb[1]) * (la[1] - lb[1]) +
+            (la[2] - lb[2]) * (la[2] - lb[2]));
+        sum += de;
+        d.maxDE = std::max(d.maxDE, (double)de);
+        if (de > GOLDEN_JND) ++d.overJnd;
+        if (diffImage) {
+            // Faded golden image, with drift past the JND in red
+            unsigned char grey = (unsigned char)(la[0] * 0.6f + 90.0f);
+            unsigned char* p = &(*diffImage)[i * 3];
+            if (de > GOLDEN_JND) { p[0] = 255; p[1] = 0; p[2] = 0; }
+            else                 { p[0] = p[1] = p[2] = grey; }
+        }
+    }
+    d.meanDE = d.pixels ? sum / (double)d.pixels : 0.0;
+    return d;
+}
+
+// Baseline: per scenario the best frame time, heap allocations per frame and the thread count
+struct BaselineEntry {
+    std::string name;
+    double      ms = 0.0;
+    uint64_t    allocations = 0;
+    unsigned    threads = 0;
+};
+
+static std::vector<BaselineEntry> ReadBaseline(const std::string& path) {
+    std::vector<BaselineEntry> entries;
+    std::FILE* fp = std::fopen(path.c_str(), "r");
+    if (!fp) return entries;
+    char line[256];
+    while (std::fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#') continue;
+        char name[64];
+        BaselineEntry e;
+        unsigned long long allocations = 0;
+        if (std::sscanf(line, "%63s %lf %llu %u", name, &e.ms, &allocations, &e.threads) == 4) {
+            e.name = name;
+            e.allocations = allocations;
+            entries.push_back(e);
+        }
+    }
+    std::fclose(fp);
+    return entries;
+}
+
+static bool WriteBaseline(const std::string& path, const std::vector<BaselineEntry>& entries) {
+    std::FILE* fp = std::fopen(path.c_str(), "w");
+    if (!fp) return false;
+    std::fprintf(fp, "# BoingGolden baseline: scenario, best frame ms, allocations per frame, threads\n");
+    for (const BaselineEntry& e : entries) {
+        std::fprintf(fp, "%s %.3f %llu %u\n", e.name.c_str(), e.ms, (unsigned long long)e.allocations, e.threads);
+    }
+    return std::fclose(fp) == 0;
+}
+
+static const BaselineEntry* FindBaseline(const std::vector<BaselineEntry>& entries, const char* name) {
+    for (const BaselineEntry& e : entries) if (e.name == name) return &e;
+    return nullptr;
+}
+
+static const Scenario* FindScenario(const char* name) {
+    for (const Scenario& sc : g_scenarios) if (std::strcmp(sc.name, name) == 0) return &sc;
+    return nullptr;
+}
+
+// Render a scenario's frame, then time the same frame repeatedly and count what it allocates. The
+// best time is kept: it is the one least disturbed by whatever else the machine is doing.
+struct RunResult {
+    std::vector<unsigned char> image;
+    double   ms = 0.0;
+    uint64_t allocations = 0;
+    size_t   triangles = 0;
+    size_t   draws = 0;        // Core renderer: draw calls for the frame
+};
+
+template <typename FrameFn>
+static void TimeFrames(RunResult& res, FrameFn&& frame) {
+    std::vector<double> times(GOLDEN_TIMED_FRAMES);
+    for (int i = 0; i < GOLDEN_WARMUP_FRAMES; ++i) frame();
+    const uint64_t allocsBefore = g_allocations.load();
+    for (int i = 0; i < GOLDEN_TIMED_FRAMES; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        frame();
+        times[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+    res.allocations = (g_allocations.load() - allocsBefore + GOLDEN_TIMED_FRAMES - 1) / GOLDEN_TIMED_FRAMES;
+    res.ms = *std::min_element(times.begin(), times.end());
+}
+
+#if BOING_GOLDEN_CORE_GL
+// Core-profile renderer
+// The saver's shader path on a headless EGL context, drawing into a framebuffer object that is read
+// back. It lights per pixel and filters the checker analytically, so it keeps golden images of its
+// own; a loose bound against the reference image of the same scenario catches a wrong scene.
+const double CORE_MAX_MEAN_DE_VS_REFERENCE = 0.75;
+const double CORE_MAX_OVER_JND_VS_REFERENCE = 0.03;     // Per ball: the two differ along checker edges and in shading
+
+static void* CoreGetProc(const char* name) {
+    return (void*)eglGetProcAddress(name);
+}
+
+class CoreBackend {
+public:
+    bool Start(const SharedAssets& assets, bool persistent) {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        display_ = getPlatformDisplay ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)
+                                      : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        EGLint major = 0, minor = 0;
+        if (display_ == EGL_NO_DISPLAY || !eglInitialize(display_, &major, &minor) || !eglBindAPI(EGL_OPENGL_API)) {
+            return Fail("no EGL display for desktop GL");
+        }
+        const EGLint attribs[] = { EGL_CONTEXT_MAJOR_VERSION, CORE_GL_MAJOR, EGL_CONTEXT_MINOR_VERSION, CORE_GL_MINOR,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+        context_ = eglCreateContext(display_, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attribs);
+        if (context_ == EGL_NO_CONTEXT || !eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+            return Fail("cannot create a GL 3.3 core context");
+        }
+
+        // Framebuffer objects are only needed here: the saver draws to its window
+        bool ok = Fetch("glGenFramebuffers", genFramebuffers_) & Fetch("glBindFramebuffer", bindFramebuffer_) &
+            Fetch("glGenRenderbuffers", genRenderbuffers_) & Fetch("glBindRenderbuffer", bindRenderbuffer_) &
+            Fetch("glRenderbufferStorage", renderbufferStorage_) &
+            Fetch("glFramebufferRenderbuffer", framebufferRenderbuffer_) &
+            Fetch("glCheckFramebufferStatus", checkFramebufferStatus_) & Fetch("glReadPixels", readPixels_) &
+            Fetch("glPixelStorei", pixelStorei_) & Fetch("glFinish", finish_);
+        if (!ok) return Fail("missing framebuffer entry points");
+        if (!renderer_.Init(CoreGetProc, assets, persistent)) return Fail(renderer_.Error());
+
+        const CoreGL& gl = renderer_.GL();
+        std::snprintf(description_, sizeof(description_), "%s, GL %s, %s", (const char*)gl.GetString(GL_RENDERER),
+            (const char*)gl.GetString(GL_VERSION), renderer_.Persistent() ? "persistent-mapped" : "staged uploads");
+        genFramebuffers_(1, &fbo_);
+        genRenderbuffers_(2, rbo_);
+        active_ = true;
+        return true;
+    }
+
+    void Stop() {
+        if (!active_) return;
+        renderer_.Release();
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display_, context_);
+        eglTerminate(display_);
+        active_ = false;
+    }
+
+    bool Active() const { return active_; }
+    const char* Description() const { return active_ ? description_ : error_; }
+    CoreRenderer& Renderer() { return renderer_; }
+
+    // Size the color and depth attachments (formats of the saver's pixel format)
+    bool Target(int w, int h) {
+        if (w == width_ && h == height_) return true;
+        bindFramebuffer_(GL_FRAMEBUFFER, fbo_);
+        bindRenderbuffer_(GL_RENDERBUFFER, rbo_[0]);
+        renderbufferStorage_(GL_RENDERBUFFER, GL_RGBA8, w, h);
+        framebufferRenderbuffer_(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rbo_[0]);
+        bindRenderbuffer_(GL_RENDERBUFFER, rbo_[1]);
+        renderbufferStorage_(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+        framebufferRenderbuffer_(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo_[1]);
+        width_ = w;
+        height_ = h;
+        return checkFramebufferStatus_(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    void Finish() { finish_(); }
+
+    // 8-bit RGB, top row first (GL reads bottom-up)
+    void Read(std::vector<unsigned char>& rgb) {
+        const size_t row = (size_t)width_ * 3;
+        rgb.resize(row * height_);
+        std::vector<unsigned char> flipped(rgb.size());
+        pixelStorei_(GL_PACK_ALIGNMENT, 1);
+        readPixels_(0, 0, width_, height_, GL_RGB, GL_UNSIGNED_BYTE, flipped.data());
+        for (int y = 0; y < height_; ++y) std::memcpy(&rgb[(size_t)y * row], &flipped[(size_t)(height_ - 1 - y) * row], row);
+    }
+
+private:
+    template <typename Fn>
+    static bool Fetch(const char* name, Fn& fn) {
+        fn = (Fn)eglGetProcAddress(name);
+        return fn != nullptr;
+    }
+
+    bool Fail(const char* why) {
+        std::snprintf(error_, sizeof(error_), "%s", why);
+        return false;
+    }
+
+    EGLDisplay   display_ = EGL_NO_DISPLAY;
+    EGLContext   context_ = EGL_NO_CONTEXT;
+    CoreRenderer renderer_;
+    bool         active_ = false;
+    char         description_[256] = {};
+    char         error_[512] = "not started";
+    GLuint       fbo_ = 0, rbo_[2] = {};
+    int          width_ = 0, height_ = 0;
+
+    PFNGLGENFRAMEBUFFERSPROC         genFramebuffers_ = nullptr;
+    PFNGLBINDFRAMEBUFFERPROC         bindFramebuffer_ = nullptr;
+    PFNGLGENRENDERBUFFERSPROC        genRenderbuffers_ = nullptr;
+    PFNGLBINDRENDERBUFFERPROC        bindRenderbuffer_ = nullptr;
+    PFNGLRENDERBUFFERSTORAGEPROC     renderbufferStorage_ = nullptr;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer_ = nullptr;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC  checkFramebufferStatus_ = nullptr;
+    void (APIENTRY* readPixels_)(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) = nullptr;
+    void (APIENTRY* pixelStorei_)(GLenum, GLint) = nullptr;
+    void (APIENTRY* finish_)() = nullptr;
+};
+
+static CoreBackend g_core;
+
+static RunResult RunCoreScenario(const SharedAssets& assets, const Scenario& sc, bool timed) {
+    RunResult res;
+    WorldBounds bounds;
+    BallBatch batch;
+    SimulateScenario(sc, bounds, batch);
+    CoreScene scene;
+    scene.width = sc.width;
+    scene.height = sc.height;
+    scene.clear[0] = (float)(sc.bgColor & 0xFF) / 255.0f;
+    scene.clear[1] = (float)((sc.bgColor >> 8) & 0xFF) / 255.0f;
+    scene.clear[2] = (float)((sc.bgColor >> 16) & 0xFF) / 255.0f;
+    scene.grid = sc.grid;
+    scene.floorShadow = sc.floorShadow;
+    scene.wallShadow = sc.wallShadow;
+    scene.lighting = sc.lighting;
+    scene.geometry = sc.geometry;
+    scene.floorY = bounds.floorY;
+    scene.ballX = batch.x;
+    scene.ballY = batch.y;
+    scene.ballZ = batch.z;
+    scene.ballSpin = batch.spin;
+    scene.ballFloorY = batch.floorY;
+    scene.ballCount = batch.size();
+
+    if (!g_core.Target(sc.width, sc.height)) return res;
+    auto frame = [&scene]() {
+        g_core.Renderer().Draw(scene);
+        g_core.Finish();
+    };
+    g_core.Renderer().TakeStats();
+    frame();
+    res.draws = (size_t)g_core.Renderer().TakeStats().draws;
+    g_core.Read(res.image);
+    const size_t sphere = assets.sphere[sc.geometry == 1 ? 1 : 0].indexCount / 3;
+    res.triangles = sphere * (1 + (sc.floorShadow ? 1 : 0) + (sc.wallShadow ? 1 : 0)) * batch.size();
+    if (sc.grid) ForEachGridLine(bounds.floorY, [&res](float, float, float, float, float, float) { res.triangles += 2; });
+    if (timed) TimeFrames(res, frame);
+    return res;
+}
+#endif
+
+static RunResult RunScenario(JobSystem& jobs, const SharedAssets& assets, const Scenario& sc, bool timed) {
+#if BOING_GOLDEN_CORE_GL
+    if (g_core.Active()) return RunCoreScenario(assets, sc, timed);
+#endif
+    RunResult res;
+    WorldBounds bounds;
+    BallBatch batch;
+    SimulateScenario(sc, bounds, batch);
+    RefRenderer ref;
+    ref.Init(assets, sc.width, sc.height);
+    auto frame = [&]() {
+        BuildFrame(ref, assets, sc, batch, bounds);
+        ref.Render(jobs);
+    };
+    frame();
+    ref.Resolve(res.image);
+    res.triangles = ref.Triangles();
+    if (timed) TimeFrames(res, frame);
+    return res;
+}
+
+enum GoldenMode { MODE_CHECK, MODE_UPDATE, MODE_BASELINE };
+
+// referenceDir is set when checking another renderer: its frames must also stay near the reference
+static int RunAll(JobSystem& jobs, const SharedAssets& assets, const std::string& dir, GoldenMode mode,
+    const std::string& referenceDir) {
+    const std::string baselinePath = dir + "/baseline.txt";
+    const std::vector<BaselineEntry> baseline = ReadBaseline(baselinePath);
+    std::vector<BaselineEntry> measured;
+    int failures = 0;
+
+    for (const Scenario& sc : g_scenarios) {
+        RunResult res = RunScenario(jobs, assets, sc, true);
+        BaselineEntry e;
+        e.name = sc.name;
+        e.ms = res.ms;
+        e.allocations = res.allocations;
+        e.threads = jobs.ThreadCount();
+        measured.push_back(e);
+
+        const std::string goldenPath = dir + "/" + sc.name + ".ppm";
+        std::printf("  %-9s %3dx%-3d %5zu tris  %7.3f ms  %llu allocs", sc.name, sc.width, sc.height, res.triangles,
+            res.ms, (unsigned long long)res.allocations);
+
+        if (mode == MODE_UPDATE) {
+            if (!WritePpm(goldenPath, sc.width, sc.height, res.image)) {
+                std::printf("  cannot write %s\n", goldenPath.c_str());
+                ++failures;
+                continue;
+            }
+            std::printf("  written\n");
+            continue;
+        }
+        if (mode == MODE_BASELINE) { std::printf("\n"); continue; }
+
+        // Image drift
+        bool failed = false;
+        int gw = 0, gh = 0;
+        std::vector<unsigned char> golden;
+        if (!ReadPpm(goldenPath, gw, gh, golden) || gw != sc.width || gh != sc.height) {
+            std::printf("  no golden image %s (run update)\n", goldenPath.c_str());
+            ++failures;
+            continue;
+        }
+        std::vector<unsigned char> diffImage;
+        const ImageDiff diff = CompareImages(golden, res.image, &diffImage);
+        const double over = (double)diff.overJnd / (double)diff.pixels;
+        std::printf("  dE mean %.3f max %.1f, %.3f%% past JND", diff.meanDE, diff.maxDE, over * 100.0);
+        if (over > GOLDEN_MAX_OVER_JND || diff.meanDE > GOLDEN_MAX_MEAN_DE) {
+            std::printf("  IMAGE DRIFT");
+            WritePpm(std::string(sc.name) + ".actual.ppm", sc.width, sc.height, res.image);
+            WritePpm(std::string(sc.name) + ".diff.ppm", sc.width, sc.height, diffImage);
+            failed = true;
+        }
+#if BOING_GOLDEN_CORE_GL
+        // Every sphere (balls and shadows) goes out as instances of one draw
+        const size_t spheres = (size_t)sc.balls * (1 + (sc.floorShadow ? 1 : 0) + (sc.wallShadow ? 1 : 0));
+        const size_t draws = (sc.grid ? 1 : 0) + (spheres + CORE_MAX_INSTANCES - 1) / CORE_MAX_INSTANCES;
+        std::printf(", %zu draws", res.draws);
+        if (res.draws != draws) {
+            std::printf("  NOT BATCHED (expected %zu)", draws);
+            failed = true;
+        }
+        std::vector<unsigned char> reference;
+        if (!referenceDir.empty() && ReadPpm(referenceDir + "/" + sc.name + ".ppm", gw, gh, reference) &&
+            gw == sc.width && gh == sc.height) {
+            const ImageDiff vs = CompareImages(reference, res.image, nullptr);
+            const double vsOver = (double)vs.overJnd / (double)vs.pixels;
+            std::printf(", vs reference %.2f / %.1f%%", vs.meanDE, vsOver * 100.0);
+            if (vsOver > CORE_MAX_OVER_JND_VS_REFERENCE * sc.balls || vs.meanDE > CORE_MAX_MEAN_DE_VS_REFERENCE) {
+                std::printf("  UNLIKE REFERENCE");
+                failed = true;
+            }
+        }
+#else
+        (void)referenceDir;   // Only the core renderer is held to the reference
+#endif
+
+        // Frame time and allocations
+        const BaselineEntry* base = FindBaseline(baseline, sc.name);
+        if (!base) {
+            std::printf("  no baseline");
+        }
+        else {
+            if (res.allocations > base->allocations) {
+                std::printf("  ALLOCATES (baseline %llu)", (unsigned long long)base->allocations);
+                failed = true;
+            }
+            if (base->threads != jobs.ThreadCount()) {
+                std::printf("  (timed with %u threads, baseline %u: not compared)", jobs.ThreadCount(), base->threads);
+            }
+            else if (res.ms > base->ms * GOLDEN_MAX_SLOWDOWN && res.ms - base->ms > GOLDEN_MIN_SLOWDOWN_MS) {
+                std::printf("  SLOWER (baseline %.3f ms)", base->ms);
+                failed = true;
+            }
+        }
+        std::printf("%s\n", failed ? "" : "  ok");
+        if (failed) ++failures;
+    }
+
+    if (mode != MODE_CHECK && !WriteBaseline(baselinePath, measured)) {
+        std::printf("  cannot write %s\n", baselinePath.c_str());
+        ++failures;
+    }
+    if (mode == MODE_CHECK) std::printf("  %s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    const char* command = argc > 1 ? argv[1] : "";
+    GoldenMode mode = MODE_CHECK;
+    if (std::strcmp(command, "update") == 0) mode = MODE_UPDATE;
+    else if (std::strcmp(command, "baseline") == 0) mode = MODE_BASELINE;
+    else if (std::strcmp(command, "check") != 0 && std::strcmp(command, "render") != 0) command = nullptr;
+    if (!command || (std::strcmp(command, "render") == 0 && argc < 4)) {
+        std::fprintf(stderr, "usage: BoingGolden check|update|baseline [golden-dir] [threads] [renderer]\n"
+            "       BoingGolden render <scenario> <out.ppm> [renderer]\n"
+            "renderer: reference (default), core, core-staged\n");
+        return 2;
+    }
+
+    SharedAssets assets;
+    GenerateSharedAssets(assets);
+    JobSystem jobs;
+
+    // Renderer: the fourth argument of every command
+    const bool render = std::strcmp(command, "render") == 0;
+    const char* renderer = argc > 4 ? argv[4] : "reference";
+    if (std::strcmp(renderer, "reference") != 0) {
+#if BOING_GOLDEN_CORE_GL
+        const bool staged = std::strcmp(renderer, "core-staged") == 0;
+        if (!staged && std::strcmp(renderer, "core") != 0) {
+            std::fprintf(stderr, "BoingGolden: unknown renderer %s\n", renderer);
+            return 2;
+        }
+        if (!g_core.Start(assets, !staged)) {
+            std::fprintf(stderr, "BoingGolden: core renderer unavailable: %s\n", g_core.Description());
+            return 2;
+        }
+#else
+        std::fprintf(stderr, "BoingGolden: built without the core renderer (-DBOING_GOLDEN_CORE_GL=1)\n");
+        return 2;
+#endif
+    }
+
+    if (render) {
+        const Scenario* sc = FindScenario(argv[2]);
+        if (!sc) {
+            std::fprintf(stderr, "BoingGolden: no scenario %s\n", argv[2]);
+            return 2;
+        }
+        jobs.Start();
+        RunResult res = RunScenario(jobs, assets, *sc, false);
+        jobs.Stop();
+#if BOING_GOLDEN_CORE_GL
+        g_core.Stop();
+#endif
+        return WritePpm(argv[3], sc->width, sc->height, res.image) ? 0 : 1;
+    }
+
+    const std::string base = argc > 2 ? argv[2] : "tools/golden";
+    const unsigned threads = argc > 3 ? (unsigned)std::atoi(argv[3]) : 1;
+    std::string dir = base, referenceDir;
+#if BOING_GOLDEN_CORE_GL
+    if (g_core.Active()) {
+        dir = base + "/core";
+        referenceDir = base;
+    }
+#endif
+    jobs.Start(threads, threads ? threads : std::thread::hardware_concurrency());
+    std::printf("BoingGolden %s: %s, %u threads, %s renderer\n", command, dir.c_str(), jobs.ThreadCount(), renderer);
+#if BOING_GOLDEN_CORE_GL
+    if (g_core.Active()) std::printf("  %s\n", g_core.Description());
+#endif
+    int rc = RunAll(jobs, assets, dir, mode, referenceDir);
+    jobs.Stop();
+#if BOING_GOLDEN_CORE_GL
+    g_core.Stop();
+#endif
+    return rc;
+}
@@ -0,0 +1,248 @@
+// BoingJobStress.cpp — stress test and benchmark for the job system in src/BoingJobs.h
+// Portable C++17, no Windows or GL headers. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -pthread -Isrc tools/BoingJobStress.cpp -o BoingJobStress
+//   ./BoingJobStress [threads] [rounds]     (threads 0 = one per core)
+// Add -fsanitize=thread (and -O1 -g) to have ThreadSanitizer watch the deques and the job graph.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "BoingJobs.h"
+#include "BoingParticles.h"
+
+static JobSystem g_jobs;
+static int g_failures = 0;
+
+static void Check(bool ok, const char* what, int round) {
+    if (ok) return;
+    ++g_failures;
+    std::printf("  FAILED: %s (round %d)\n", what, round);
+}
+
+static double Seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Fork/join: every job spawns two children down to a depth, leaves count themselves
+struct TreeArgs {
+    std::atomic<int64_t>* leaves;
+    int depth;
+};
+
+static void TreeJob(Job* job, const void* payload) {
+    TreeArgs args = *(const TreeArgs*)payload;
+    if (args.depth == 0) { args.leaves->fetch_add(1, std::memory_order_relaxed); return; }
+    TreeArgs child = { args.leaves, args.depth - 1 };
+    g_jobs.Run(g_jobs.Create(TreeJob, &child, sizeof(child), job));
+    g_jobs.Run(g_jobs.Create(TreeJob, &child, sizeof(child), job));
+}
+
+static void TestTree(int round) {
+    std::atomic<int64_t> leaves(0);
+    TreeArgs args = { &leaves, 9 };      // 1023 jobs: stays inside the per-thread ring
+    Job* root = g_jobs.Create(TreeJob, &args, sizeof(args));
+    g_jobs.Run(root);
+    g_jobs.Wait(root);
+    Check(leaves.load() == 512, "fork/join tree leaf count", round);
+}
+
+// Fan-out wider than the job ring: Create has to run queued children to free slots
+static void TestWideFanOut(int round) {
+    std::atomic<int64_t> done(0);
+    std::atomic<int64_t>* d = &done;
+    const int children = (int)JOB_RING_SIZE * 3;
+    Job* root = g_jobs.Create([d, children](Job* self) {
+        for (int i = 0; i < children; ++i) g_jobs.Run(g_jobs.Create([d](Job*) { d->fetch_add(1, std::memory_order_relaxed); }, self));
+    });
+    g_jobs.Run(root);
+    g_jobs.Wait(root);
+    Check(done.load() == children, "fan-out past the job ring lost children", round);
+}
+
+// Task graph: a -> (b, c) -> d, where d must see what b and c wrote, repeated as a chain
+static void TestGraph(int round) {
+    const int links = 64;
+    std::vector<int> value(links * 3, 0);
+    std::atomic<int> order(0), bad(0);
+    int* v = value.data();
+    std::atomic<int>* o = &order;
+    std::atomic<int>* b = &bad;
+
+    Job* first = nullptr;
+    Job* last = nullptr;
+    for (int i = 0; i < links; ++i) {
+        int* slot = v + i * 3;
+        // The branches are children of an empty join job, so it finishes only after both; the
+        // head starts them and the check follows the join
+        Job* join = g_jobs.Create([](Job*) {});
+        Job* head = g_jobs.Create([slot, o](Job*) { slot[0] = o->fetch_add(1) + 1; });
+        Job* left = g_jobs.Create([slot](Job*) { slot[1] = slot[0] * 2; }, join);
+        Job* right = g_jobs.Create([slot](Job*) { slot[2] = slot[0] * 3; }, join);
+        Job* check = g_jobs.Create([slot, b](Job*) { if (slot[1] != slot[0] * 2 || slot[2] != slot[0] * 3) b->fetch_add(1); });
+        g_jobs.AddContinuation(head, left);
+        g_jobs.AddContinuation(head, right);
+        g_jobs.AddContinuation(join, check);
+        if (last) g_jobs.AddContinuation(last, head);
+        else first = head;
+        last = check;
+        g_jobs.Run(join);
+    }
+    g_jobs.Run(first);
+    g_jobs.Wait(last);
+
+    bool ordered = true;
+    for (int i = 0; i < links; ++i) ordered &= (value[i * 3] == i + 1);
+    Check(bad.load() == 0, "join saw unfinished branches", round);
+    Check(ordered, "continuation chain ran out of order", round);
+}
+
+// ParallelFor: every index visited exactly once, for several grains
+static void TestParallelFor(int round, std::vector<uint32_t>& hits) {
+    const size_t grains[] = { 1, 7, 64, 1000, 100000 };
+    for (size_t grain : grains) {
+        std::fill(hits.begin(), hits.end(), 0u);
+        uint32_t* h = hits.data();
+        g_jobs.ParallelFor(hits.size(), grain, [h](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) h[i] += 1;
+        });
+        bool once = true;
+        for (uint32_t x : hits) once &= (x == 1);
+        Check(once, "ParallelFor visited an index other than once", round);
+    }
+}
+
+// Tiles: a checkerboard raster, compared with the same raster drawn serially
+static void TestTiles(int round) {
+    const int w = 997, h = 533, tile = 64;
+    std::vector<uint32_t> image((size_t)w * h, 0), reference((size_t)w * h, 0);
+    auto shade = [](int x, int y) { return (uint32_t)((((x >> 4) ^ (y >> 4)) & 1) ? 0xFFFFFFu : (uint32_t)(x * 31 + y * 17)); };
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) reference[(size_t)y * w + x] = shade(x, y);
+
+    uint32_t* img = image.data();
+    g_jobs.ParallelForTiles(w, h, tile, [img, w, &shade](int x0, int y0, int x1, int y1) {
+        for (int y = y0; y < y1; ++y)
+            for (int x = x0; x < x1; ++x) img[(size_t)y * w + x] += shade(x, y);
+    });
+    Check(image == reference, "tiled raster differs from the serial one", round);
+}
+
+// Particles: chunked integration must match the serial update bit for bit
+static ParticlePool g_serial, g_chunked;
+
+static void FillPools() {
+    g_serial.Clear();
+    g_chunked.Clear();
+    for (size_t k = 0; k < PARTICLE_CAPACITY / 64; ++k) {
+        float px = -0.8f + 1.6f * (float)(k % 17) / 17.0f;
+        g_serial.Emit(k % 3, px, -0.5f, 0.1f, 0.0f, 1.0f, 0.0f, 1.2f, -0.83f, 0x00A0B0C0u, 64);
+        g_chunked.Emit(k % 3, px, -0.5f, 0.1f, 0.0f, 1.0f, 0.0f, 1.2f, -0.83f, 0x00A0B0C0u, 64);
+    }
+}
+
+static void TestParticles(int round) {
+    FillPools();
+    const size_t chunk = 512;
+    bool same = true;
+    for (int step = 0; step < 90 && g_serial.Live(); ++step) {
+        const float dt = 1.0f / 60.0f;
+        g_serial.Update(dt, -9.8f);
+        const size_t live = g_chunked.Live();
+        g_jobs.ParallelFor((live + chunk - 1) / chunk, 1, [live, dt](size_t begin, size_t end) {
+            g_chunked.Integrate(begin * chunk, end * chunk < live ? end * chunk : live, dt, -9.8f);
+        });
+        g_chunked.FinishUpdate();
+
+        same &= (g_serial.Live() == g_chunked.Live());
+        for (size_t w = 0; w < 3 && same; ++w) {
+            same &= g_serial.LiveIn(w) == g_chunked.LiveIn(w) &&
+                std::memcmp(g_serial.VerticesOf(w), g_chunked.VerticesOf(w), g_serial.LiveIn(w) * sizeof(ParticleVertex)) == 0;
+        }
+    }
+    Check(same, "chunked particle update differs from the serial one", round);
+
+    // A range that ends inside a SIMD group moves its particles and leaves the rest of the group alone
+    FillPools();
+    g_chunked.Integrate(0, 6, 1.0f / 60.0f, -9.8f);
+    g_serial.FinishUpdate();
+    g_chunked.FinishUpdate();
+    const ParticleVertex* moved = g_chunked.VerticesOf(0);
+    const ParticleVertex* still = g_serial.VerticesOf(0);
+    Check(g_serial.LiveIn(0) > 8 && std::memcmp(moved, still, 6 * sizeof(ParticleVertex)) != 0 &&
+        std::memcmp(moved + 6, still + 6, (g_serial.LiveIn(0) - 6) * sizeof(ParticleVertex)) == 0,
+        "particle integration ran past the end of its range", round);
+}
+
+// Throughput: tiny jobs, and a ParallelFor with real work against one thread doing it all
+static std::atomic<float> g_sink(0.0f);
+
+static void Bench() {
+    auto t0 = std::chrono::steady_clock::now();
+    const int batches = 2000;
+    for (int b = 0; b < batches; ++b) {
+        Job* root = g_jobs.Create([](Job*) {});
+        for (int i = 0; i < 256; ++i) g_jobs.Run(g_jobs.Create([](Job*) {}, root));
+        g_jobs.Run(root);
+        g_jobs.Wait(root);
+    }
+    double s = Seconds(t0);
+    std::printf("  empty jobs     %.2f M/s (%.0f ns each)\n", batches * 257 / s / 1e6, s / (batches * 257) * 1e9);
+
+    std::vector<float> data(1 << 22);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = (float)(i % 1000) * 0.001f;
+    auto work = [&data](size_t begin, size_t end) {
+        float acc = 0.0f;
+        for (size_t i = begin; i < end; ++i) {
+            float x = data[i];
+            for (int k = 0; k < 16; ++k) x = x * 0.999f + 0.001f;
+            acc += x;
+        }
+        g_sink.store(acc, std::memory_order_relaxed);
+    };
+    work(0, data.size());    // Warm up
+    t0 = std::chrono::steady_clock::now();
+    work(0, data.size());
+    double serial = Seconds(t0);
+    t0 = std::chrono::steady_clock::now();
+    g_jobs.ParallelFor(data.size(), 16384, work);
+    double parallel = Seconds(t0);
+    std::printf("  parallel for   %.2f ms serial, %.2f ms on %u threads (%.1fx)\n", serial * 1e3, parallel * 1e3,
+        g_jobs.ThreadCount(), serial / parallel);
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = argc > 1 ? (unsigned)std::atoi(argv[1]) : 0;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (rounds <= 0) {
+        std::fprintf(stderr, "usage: BoingJobStress [threads] [rounds]\n");
+        return 2;
+    }
+
+    g_jobs.Start(threads, threads);     // Exactly that many, even beyond the core count
+    std::printf("BoingJobStress: %u threads, %d rounds\n", g_jobs.ThreadCount(), rounds);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<uint32_t> hits(100003);
+    for (int r = 0; r < rounds; ++r) {
+        TestTree(r);
+        TestGraph(r);
+        if (r % 10 == 0) TestWideFanOut(r);
+        TestParallelFor(r, hits);
+        if (r % 10 == 0) TestTiles(r);
+        if (r % 10 == 0) TestParticles(r);
+    }
+    std::printf("  stress         %.2f s, %s\n", Seconds(t0), g_failures ? "FAILED" : "all passed");
+
+    Bench();
+
+    for (unsigned i = 0; i < g_jobs.ThreadCount(); ++i) {
+        JobThreadStats s = g_jobs.TakeStats(i);
+        std::printf("  thread %-2u      %llu jobs, %llu stolen, %.1f ms busy\n", i, (unsigned long long)s.jobs,
+            (unsigned long long)s.steals, (double)s.busyNs / 1e6);
+    }
+    g_jobs.Stop();
+    return g_failures ? 1 : 0;
+}
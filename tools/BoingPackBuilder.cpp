@@ -0,0 +1,128 @@
+// BoingPackBuilder.cpp — builds BoingBallSaver.pak (checker mip chain, sphere LODs, bounce sounds)
+// Portable C++17, no Windows headers. Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingPackBuilder.cpp -o BoingPackBuilder
+//   ./BoingPackBuilder sounds BoingBallSaver.pak
+// Copy the pack next to BoingBallSaver.scr; the saver falls back to generated assets without it.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BoingAssets.h"
+#include "BoingAudio.h"
+
+// Whole-file read
+static bool ReadFile(const std::string& path, std::vector<unsigned char>& out) {
+    std::FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    std::fseek(fp, 0, SEEK_END);
+    long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && std::fread(out.data(), 1, out.size(), fp) == out.size();
+    std::fclose(fp);
+    return ok;
+}
+
+struct PackWriter {
+    std::vector<unsigned char> payload;      // Everything after the entry table
+    std::vector<AssetPackEntry> entries;
+
+    // Append an aligned payload and remember its entry (offsets are fixed up in Finish)
+    unsigned char* Add(uint32_t id, size_t size, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0) {
+        payload.resize(AssetAlignUp((uint32_t)payload.size()), 0);
+        AssetPackEntry e = { id, (uint32_t)payload.size(), (uint32_t)size, a, b, c };
+        entries.push_back(e);
+        payload.resize(payload.size() + size, 0);
+        return &payload[e.offset];
+    }
+
+    std::vector<unsigned char> Finish() {
+        uint32_t tableEnd = AssetAlignUp((uint32_t)(sizeof(AssetPackHeader) + entries.size() * sizeof(AssetPackEntry)));
+        for (auto& e : entries) e.offset += tableEnd;
+
+        AssetPackHeader header = { ASSET_PACK_MAGIC, ASSET_PACK_VERSION, (uint32_t)entries.size(),
+            tableEnd + (uint32_t)payload.size() };
+        std::vector<unsigned char> file(header.totalSize, 0);
+        std::memcpy(&file[0], &header, sizeof(header));
+        std::memcpy(&file[sizeof(header)], entries.data(), entries.size() * sizeof(AssetPackEntry));
+        if (!payload.empty()) std::memcpy(&file[tableEnd], payload.data(), payload.size());
+        return file;
+    }
+};
+
+static void AddSphere(PackWriter& pack, uint32_t id, int slices, int stacks) {
+    SphereMesh mesh;
+    BuildSphereMesh(mesh, slices, stacks, ASSET_BALL_RADIUS);
+    uint32_t off[4];
+    uint32_t size = SphereSectionLayout(slices, stacks, off);
+    uint32_t radiusBits;
+    std::memcpy(&radiusBits, &ASSET_BALL_RADIUS, sizeof(radiusBits));
+
+    unsigned char* p = pack.Add(id, size, (uint32_t)slices, (uint32_t)stacks, radiusBits);
+    std::memcpy(p + off[0], mesh.positions.data(), mesh.positions.size() * sizeof(float));
+    std::memcpy(p + off[1], mesh.normals.data(), mesh.normals.size() * sizeof(float));
+    std::memcpy(p + off[2], mesh.texcoords.data(), mesh.texcoords.size() * sizeof(float));
+    std::memcpy(p + off[3], mesh.indices.data(), mesh.indices.size() * sizeof(uint16_t));
+}
+
+static bool AddSound(PackWriter& pack, uint32_t id, const std::string& path) {
+    std::vector<unsigned char> file, wav;
+    if (!ReadFile(path, file)) {
+        std::fprintf(stderr, "BoingPackBuilder: cannot read %s\n", path.c_str());
+        return false;
+    }
+
+    // The pack always holds pre-decoded PCM, whichever form the source is in
+    if (!DecodeToPcmWave(file.data(), file.size(), wav)) {
+        std::fprintf(stderr, "BoingPackBuilder: %s is not a 16-bit PCM or IMA ADPCM WAVE file\n", path.c_str());
+        return false;
+    }
+    std::memcpy(pack.Add(id, wav.size()), wav.data(), wav.size());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string soundDir = (argc > 1) ? argv[1] : "sounds";
+    std::string outPath = (argc > 2) ? argv[2] : ASSET_PACK_FILE;
+
+    PackWriter pack;
+
+    std::vector<unsigned char> texels;
+    TextureMip mips[MIP_MAX_LEVELS];
+    int levels = 0;
+    BuildCheckerMips(texels, mips, levels);
+    std::memcpy(pack.Add(ASSET_CHECKER_MIPS, texels.size(), (uint32_t)CHECKER_TEX_SIZE, (uint32_t)levels),
+        texels.data(), texels.size());
+
+    AddSphere(pack, ASSET_SPHERE_SMOOTH, SPHERE_SMOOTH_SLICES, SPHERE_SMOOTH_STACKS);
+    AddSphere(pack, ASSET_SPHERE_CLASSIC, SPHERE_CLASSIC_SLICES, SPHERE_CLASSIC_STACKS);
+
+    if (!AddSound(pack, ASSET_SOUND_FLOOR, soundDir + "/BoingBallF.wav")) return 1;
+    if (!AddSound(pack, ASSET_SOUND_WALL, soundDir + "/BoingBallW.wav")) return 1;
+
+    std::vector<unsigned char> file = pack.Finish();
+
+    // The saver must accept what we just wrote
+    SharedAssets check;
+    if (!AttachAssetPack(check, file.data(), file.size())) {
+        std::fprintf(stderr, "BoingPackBuilder: pack failed validation\n");
+        return 1;
+    }
+
+    std::FILE* fp = std::fopen(outPath.c_str(), "wb");
+    if (!fp || std::fwrite(file.data(), 1, file.size(), fp) != file.size()) {
+        std::fprintf(stderr, "BoingPackBuilder: cannot write %s\n", outPath.c_str());
+        if (fp) std::fclose(fp);
+        return 1;
+    }
+    std::fclose(fp);
+
+    static const char* names[] = { "", "checker mips", "sphere smooth", "sphere classic", "sound floor", "sound wall" };
+    for (const auto& e : pack.entries) {
+        std::printf("  %-15s offset %8u  size %8u\n", names[e.id], e.offset, e.size);
+    }
+    std::printf("%s: %zu bytes, %zu entries\n", outPath.c_str(), file.size(), pack.entries.size());
+    return 0;
+}
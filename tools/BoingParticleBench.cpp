@@ -0,0 +1,45 @@
+// BoingParticleBench.cpp — times the impact particle pool update at several live counts
+// Portable C++17, no Windows or GL headers. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingParticleBench.cpp -o BoingParticleBench
+//   ./BoingParticleBench
+// Add -U__SSE2__ to time the scalar path.
+
+#include <chrono>
+#include <cstdio>
+
+#include "BoingParticles.h"
+
+static ParticlePool g_pool;
+
+// Keep the pool topped up at the target count (emitting like a stream of floor hits) and time updates
+static void Bench(size_t live) {
+    g_pool.Clear();
+    const float dt = 1.0f / 120.0f;
+    int frames = 0;
+    double ms = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        while (g_pool.Live() < live) {
+            size_t want = live - g_pool.Live();
+            g_pool.Emit(0, 0.0f, -0.8f, 0.0f, 0.0f, 1.0f, 0.0f, 1.2f, -0.8f, 0x00B8C8D0, want < 48 ? want : 48);
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        g_pool.Update(dt, -9.8f);
+        ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        ++frames;
+    } while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < 0.5);
+
+    std::printf("  %5zu live  %7.2f us per update  %5.2f ns per particle  (%d updates)\n",
+        live, 1000.0 * ms / frames, 1e6 * ms / frames / (double)live, frames);
+}
+
+int main() {
+#if BOING_PARTICLES_SSE
+    std::printf("Particle update: SSE path\n");
+#else
+    std::printf("Particle update: scalar path\n");
+#endif
+    const size_t counts[] = { 256, 1024, 4096, PARTICLE_CAPACITY };
+    for (size_t live : counts) Bench(live);
+    return 0;
+}
@@ -0,0 +1,153 @@
+// BoingPowerBench.cpp — CPU time and wakeups of the saver's main loop, polling against paced
+// POSIX (Linux): clock_nanosleep, getrusage and timer slack stand in for the saver's waitable timers
+// and GetProcessTimes. Build from the repository root, e.g.:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingPowerBench.cpp -o BoingPowerBench
+//   ./BoingPowerBench [seconds per mode] [display Hz] [draw ms]
+// Every mode runs the loop's per-frame CPU work (a simulation step, the particle update with
+// emission on impacts, and draw ms of busy time standing in for draw submission):
+//   poll       the loop before pacing: a frame, then Sleep(1) (1 ms here; a scheduler tick on Windows)
+//   full       FramePacer at the display rate
+//   low-power  FramePacer at the low-power cadence, its tolerance as timer slack
+//   hidden     display off: housekeeping wakeups only, no frame work
+// Exits 1 when a paced mode costs more CPU or wakes more often than polling.
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <sys/prctl.h>
+#include <sys/resource.h>
+
+#include "BoingPacing.h"
+#include "BoingParticles.h"
+#include "BoingSim.h"
+
+static uint64_t NowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t CpuNs(const rusage& r) {
+    return (uint64_t)(r.ru_utime.tv_sec + r.ru_stime.tv_sec) * 1000000000ull +
+        (uint64_t)(r.ru_utime.tv_usec + r.ru_stime.tv_usec) * 1000ull;
+}
+
+static void SleepUntil(uint64_t deadlineNs) {
+    timespec ts;
+    ts.tv_sec = (time_t)(deadlineNs / 1000000000ull);
+    ts.tv_nsec = (long)(deadlineNs % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) != 0) {}
+}
+
+// The main loop's own work for one frame
+class FrameWork {
+public:
+    explicit FrameWork(double drawMs) : drawNs_((uint64_t)(drawMs * 1e6)) {}
+
+    void Run(float dt) {
+        const WorldBounds bounds;
+        const SimParams params;
+        SimImpacts impacts;
+        StepBall(ball_, bounds, params, dt * 0.5f, &impacts);     // The saver's time scale
+        for (int i = 0; i < impacts.count; ++i) {
+            const SimImpact& h = impacts.list[i];
+            const bool floor = h.event == SIM_EVENT_FLOOR;
+            pool_.Emit(0, h.x, floor ? bounds.floorY : h.y, h.z, floor ? 0.0f : (h.x < 0.0f ? 1.0f : -1.0f),
+                floor ? 1.0f : 0.0f, 0.0f, floor ? 1.2f : 1.8f, bounds.floorY, 0x00B8C8D0, floor ? 48 : 32);
+        }
+        pool_.Update(dt * 0.5f, -9.8f);
+        const uint64_t until = NowNs() + drawNs_;
+        while (NowNs() < until) {}
+    }
+
+private:
+    uint64_t     drawNs_;
+    BallState    ball_;
+    ParticlePool pool_;
+};
+
+struct ModeResult {
+    double cpuMsPerMin = 0.0;
+    double wakeupsPerSec = 0.0;     // The loop's own sleeps that returned
+    double switchesPerSec = 0.0;    // Voluntary context switches, as the kernel counts them
+    double framesPerSec = 0.0;
+};
+
+static ModeResult RunMode(const char* name, double seconds, FramePacer& pacer, int mode, FrameWork& work) {
+    const PacingCadence cadences[] = { CADENCE_FULL, CADENCE_FULL, CADENCE_LOW_POWER, CADENCE_HIDDEN };
+    const PacingCadence cadence = cadences[mode];
+    prctl(PR_SET_TIMERSLACK, mode == 0 ? 1ul : (unsigned long)(pacer.ToleranceNs(cadence) > 1 ?
+        pacer.ToleranceNs(cadence) : 1));
+
+    PowerCounters counters;
+    rusage r0, r1;
+    getrusage(RUSAGE_SELF, &r0);
+    const uint64_t start = NowNs(), end = start + (uint64_t)(seconds * 1e9);
+    uint64_t prev = start, now = start;
+    pacer.NextDeadline(start, cadence);     // Start a fresh grid
+    while (now < end) {
+        if (cadence != CADENCE_HIDDEN) {
+            float dt = (float)((double)(now - prev) / 1e9);
+            if (dt > PACING_MAX_STEP) dt = PACING_MAX_STEP;
+            prev = now;
+            work.Run(dt);
+            counters.frames++;
+        }
+        if (mode == 0) {
+            SleepUntil(NowNs() + 1000000);
+            counters.wakeups++;
+        }
+        else {
+            const uint64_t t = NowNs();
+            const uint64_t deadline = pacer.NextDeadline(t, cadence);
+            if (deadline > t) {
+                SleepUntil(deadline);
+                counters.wakeups++;
+            }
+        }
+        now = NowNs();
+    }
+    getrusage(RUSAGE_SELF, &r1);
+    const double elapsed = (double)(now - start) / 1e9;
+
+    ModeResult res;
+    res.cpuMsPerMin = CpuMsPerMinute(CpuNs(r1) - CpuNs(r0), elapsed);
+    res.wakeupsPerSec = PerSecond(counters.wakeups, elapsed);
+    res.switchesPerSec = PerSecond((uint64_t)(r1.ru_nvcsw - r0.ru_nvcsw), elapsed);
+    res.framesPerSec = PerSecond(counters.frames, elapsed);
+    char fps[16];
+    if (mode == 0) std::snprintf(fps, sizeof(fps), "uncapped");
+    else           std::snprintf(fps, sizeof(fps), "%u fps", pacer.Fps(cadence));
+    std::printf("  %-10s %-8s  %8.0f cpu-ms/min  %7.1f wakeups/s  %7.1f switches/s  %7.1f frames/s\n", name, fps,
+        res.cpuMsPerMin, res.wakeupsPerSec, res.switchesPerSec, res.framesPerSec);
+    return res;
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 5.0;
+    const uint32_t hz = argc > 2 ? (uint32_t)std::atoi(argv[2]) : 60;
+    const double drawMs = argc > 3 ? std::atof(argv[3]) : 0.3;
+    if (seconds <= 0.0 || drawMs < 0.0) {
+        std::fprintf(stderr, "usage: BoingPowerBench [seconds per mode] [display Hz] [draw ms]\n");
+        return 2;
+    }
+
+    FramePacer pacer;
+    pacer.Configure(0, hz);
+    FrameWork work(drawMs);
+    std::printf("BoingPowerBench: %.0f s per mode, %u Hz display, %.2f ms draw per frame\n", seconds, hz, drawMs);
+    const char* names[] = { "poll", "full", "low-power", "hidden" };
+    ModeResult res[4];
+    for (int mode = 0; mode < 4; ++mode) res[mode] = RunMode(names[mode], seconds, pacer, mode, work);
+
+    bool ok = true;
+    for (int mode = 1; mode < 4; ++mode) {
+        const double cpu = res[0].cpuMsPerMin > 0.0 ? res[mode].cpuMsPerMin / res[0].cpuMsPerMin : 0.0;
+        const double wake = res[0].wakeupsPerSec > 0.0 ? res[mode].wakeupsPerSec / res[0].wakeupsPerSec : 0.0;
+        std::printf("  %-10s %5.1f%% of polling's CPU, %5.1f%% of its wakeups\n", names[mode], 100.0 * cpu, 100.0 * wake);
+        if (res[mode].cpuMsPerMin > res[0].cpuMsPerMin || res[mode].wakeupsPerSec > res[0].wakeupsPerSec) ok = false;
+    }
+    std::printf("  %s\n", ok ? "paced modes cost less than polling" : "FAILED: a paced mode costs more than polling");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+// BoingReplay.cpp — replays a run recorded with "BoingBallSaver.scr /s /record run.bbr" through the
+// simulation core, headless, and checks every collision event and ball state bit for bit
+// Portable C++17, no Windows or GL headers. Build from the repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -ffp-contract=off -Isrc tools/BoingReplay.cpp -o BoingReplay
+//   ./BoingReplay verify run.bbr [trace.csv]     (trace: one line per ball per tick, for diffing builds)
+//   ./BoingReplay bench run.bbr
+//   ./BoingReplay synth run.bbr [ticks] [balls]  (a recording made without the saver, for benchmarks)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "BoingReplay.h"
+
+static bool ReadFile(const char* path, std::vector<unsigned char>& out) {
+    std::FILE* fp = std::fopen(path, "rb");
+    if (!fp) return false;
+    std::fseek(fp, 0, SEEK_END);
+    long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && std::fread(out.data(), 1, out.size(), fp) == out.size();
+    std::fclose(fp);
+    return ok;
+}
+
+struct ReplayResult {
+    uint64_t ticks = 0;
+    uint64_t steps = 0;          // Ball steps (ticks x balls)
+    uint64_t events = 0;         // Recorded impacts
+    uint64_t mismatches = 0;
+    uint32_t endTicks = 0;
+    bool     ended = false;
+};
+
+// Same impacts in the same order at bitwise identical times
+static bool SameImpacts(const SimImpacts& a, const SimImpacts& b) {
+    if (a.count != b.count) return false;
+    for (int i = 0; i < a.count; ++i) {
+        if (a.list[i].event != b.list[i].event) return false;
+        if (std::memcmp(&a.list[i].t, &b.list[i].t, sizeof(float)) != 0) return false;
+    }
+    return true;
+}
+
+// Impacts computed for the current tick must all be matched by EVENT records before the next one
+static void CheckUnmatched(const std::vector<SimImpacts>& pending, uint64_t tick, ReplayResult& res, bool report) {
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].count == 0) continue;
+        ++res.mismatches;
+        if (report) std::printf("  tick %llu ball %zu: replay raised %d impacts, recording has none\n",
+            (unsigned long long)tick, i, pending[i].count);
+    }
+}
+
+static bool Replay(const std::vector<unsigned char>& data, ReplayResult& res, std::FILE* trace, bool report) {
+    ReplayReader reader;
+    if (!reader.Open(data)) return false;
+
+    std::vector<BallState> balls;
+    std::vector<WorldBounds> bounds;
+    std::vector<SimImpacts> pending;
+    ReplayRecord r;
+    while (reader.Next(r)) {
+        if (r.op != REPLAY_OP_EVENT) {
+            CheckUnmatched(pending, res.ticks, res, report);
+            pending.assign(balls.size(), SimImpacts());
+        }
+
+        switch (r.op) {
+        case REPLAY_OP_LAYOUT:
+            if (r.continued) {
+                for (size_t i = 0; i < balls.size() && i < r.balls.size(); ++i) {
+                    if (SameBallState(balls[i], r.balls[i])) continue;
+                    ++res.mismatches;
+                    if (report) std::printf("  tick %llu ball %zu: state differs from the recording\n",
+                        (unsigned long long)res.ticks, i);
+                }
+            }
+            balls = r.balls;
+            bounds = r.bounds;
+            pending.assign(balls.size(), SimImpacts());
+            break;
+
+        case REPLAY_OP_TICK:
+            for (size_t i = 0; i < balls.size(); ++i) {
+                uint32_t events = StepBall(balls[i], bounds[i], reader.params, r.dt, &pending[i]);
+                if (trace) {
+                    const BallState& b = balls[i];
+                    std::fprintf(trace, "%llu,%zu,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%d,%u,%.9g\n",
+                        (unsigned long long)res.ticks, i, b.x, b.y, b.z, b.vx, b.vy, b.vz, b.spin, b.spinDir, events,
+                        pending[i].count ? pending[i].list[0].t : 0.0f);
+                }
+            }
+            res.steps += balls.size();
+            ++res.ticks;
+            break;
+
+        case REPLAY_OP_EVENT:
+            res.events += (uint64_t)r.impacts.count;
+            if (r.ball < pending.size() && SameImpacts(pending[r.ball], r.impacts)) {
+                pending[r.ball] = SimImpacts();
+                break;
+            }
+            ++res.mismatches;
+            if (report) std::printf("  tick %llu ball %u: recorded %d impacts, replay raised %d (or at other times)\n",
+                (unsigned long long)res.ticks - 1, r.ball, r.impacts.count, r.ball < pending.size() ? pending[r.ball].count : 0);
+            if (r.ball < pending.size()) pending[r.ball] = SimImpacts();
+            break;
+
+        case REPLAY_OP_END:
+            res.ended = true;
+            res.endTicks = r.ticks;
+            return true;
+        }
+    }
+    CheckUnmatched(pending, res.ticks, res, report);
+    return true;   // Truncated (saver killed mid-run): everything read so far was checked
+}
+
+static int Verify(const char* path, const char* tracePath) {
+    std::vector<unsigned char> data;
+    ReplayReader header;
+    if (!ReadFile(path, data) || !header.Open(data)) {
+        std::fprintf(stderr, "BoingReplay: %s is not a BoingBallSaver recording\n", path);
+        return 1;
+    }
+    std::FILE* trace = nullptr;
+    if (tracePath) {
+        trace = std::fopen(tracePath, "w");
+        if (!trace) {
+            std::fprintf(stderr, "BoingReplay: cannot write %s\n", tracePath);
+            return 1;
+        }
+        std::fprintf(trace, "tick,ball,x,y,z,vx,vy,vz,spin,spinDir,events,firstImpactT\n");
+    }
+
+    std::printf("%s\n", path);
+    std::printf("  settings    mode %d, sound %d, impostor %d, geometry %d\n", header.settings.multiMonitorMode,
+        header.settings.sound, header.settings.impostor, header.settings.geometryMode);
+    std::printf("  sim         radius %g, gravity %g, spin %g deg/s, bounce %g\n", header.params.radius,
+        header.params.gravity, header.params.spinSpeed, header.params.bounceVy);
+
+    ReplayResult res;
+    Replay(data, res, trace, true);
+    if (trace) std::fclose(trace);
+
+    if (res.ended && res.endTicks != res.ticks) ++res.mismatches;
+    std::printf("  replayed    %llu ticks, %llu ball steps, %llu impacts%s\n", (unsigned long long)res.ticks,
+        (unsigned long long)res.steps, (unsigned long long)res.events, res.ended ? "" : " (recording truncated)");
+    std::printf("  result      %s (%llu mismatches)\n", res.mismatches ? "DIVERGED" : "bit-exact",
+        (unsigned long long)res.mismatches);
+    return res.mismatches ? 1 : 0;
+}
+
+// Whole-log replay throughput, repeating for at least half a second
+static int Bench(const char* path) {
+    std::vector<unsigned char> data;
+    ReplayReader header;
+    if (!ReadFile(path, data) || !header.Open(data)) {
+        std::fprintf(stderr, "BoingReplay: %s is not a BoingBallSaver recording\n", path);
+        return 1;
+    }
+
+    ReplayResult res;
+    auto t0 = std::chrono::steady_clock::now();
+    int runs = 0;
+    double seconds = 0.0;
+    do {
+        res = ReplayResult();
+        Replay(data, res, nullptr, false);
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (seconds < 0.5);
+
+    double perRun = seconds / runs;
+    std::printf("%s\n", path);
+    std::printf("  log         %zu bytes, %llu ticks, %llu ball steps\n", data.size(),
+        (unsigned long long)res.ticks, (unsigned long long)res.steps);
+    std::printf("  replay      %.3f ms per run, %.2f Mticks/s, %.2f Msteps/s (%d runs)\n", perRun * 1000.0,
+        (double)res.ticks / perRun / 1e6, (double)res.steps / perRun / 1e6, runs);
+    std::printf("  result      %s\n", res.mismatches ? "DIVERGED" : "bit-exact");
+    return res.mismatches ? 1 : 0;
+}
+
+// Record a run the way the saver's per-output modes do: jittered frame times around 60 Hz, one
+// ball per output, a resize halfway through
+static int Synth(const char* path, int ticks, int ballCount) {
+    std::FILE* fp = std::fopen(path, "wb");
+    SaverSettings settings;
+    settings.multiMonitorMode = MONITOR_MODE_EXTENDED;
+    SimParams params;
+    ReplayWriter writer;
+    if (!writer.Open(fp, params, settings)) {
+        std::fprintf(stderr, "BoingReplay: cannot write %s\n", path);
+        return 1;
+    }
+
+    std::vector<BallState> balls((size_t)ballCount);
+    std::vector<WorldBounds> bounds((size_t)ballCount);
+    for (int i = 0; i < ballCount; ++i) {
+        balls[i].x = -0.5f + 0.05f * (float)i;
+        balls[i].spinDir = (i & 1) ? -1 : 1;
+        bounds[i] = { 0.83f + 0.1f * (float)(i % 3), 0.83f, -0.83f };
+    }
+    writer.Layout(balls.size(), balls.data(), bounds.data(), false);
+
+    uint32_t seed = 2024u;
+    for (int t = 0; t < ticks; ++t) {
+        if (t == ticks / 2) {
+            for (auto& w : bounds) w.wallX *= 0.75f;
+            writer.Layout(balls.size(), balls.data(), bounds.data(), true);
+        }
+        seed = seed * 1664525u + 1013904223u;
+        float dt = (1.0f / 60.0f + (float)(seed >> 24) * (0.004f / 255.0f)) * 0.5f;   // g_timeScale 0.5
+        writer.Tick(dt);
+        for (size_t i = 0; i < balls.size(); ++i) {
+            SimImpacts impacts;
+            StepBall(balls[i], bounds[i], params, dt, &impacts);
+            writer.Impacts(i, impacts);
+        }
+    }
+    writer.Close();
+    std::printf("%s: %d ticks, %d balls\n", path, ticks, ballCount);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if ((argc == 3 || argc == 4) && std::strcmp(argv[1], "verify") == 0) return Verify(argv[2], argc == 4 ? argv[3] : nullptr);
+    if (argc == 3 && std::strcmp(argv[1], "bench") == 0) return Bench(argv[2]);
+    if (argc >= 3 && argc <= 5 && std::strcmp(argv[1], "synth") == 0) {
+        int ticks = argc > 3 ? std::atoi(argv[3]) : 36000;
+        int balls = argc > 4 ? std::atoi(argv[4]) : 1;
+        if (ticks > 0 && balls > 0 && (size_t)balls <= REPLAY_MAX_BALLS) return Synth(argv[2], ticks, balls);
+    }
+    std::fprintf(stderr, "usage: BoingReplay verify run.bbr [trace.csv]\n"
+        "       BoingReplay bench run.bbr\n"
+        "       BoingReplay synth run.bbr [ticks] [balls]\n");
+    return 2;
+}
@@ -0,0 +1,179 @@
+// BoingSettingsCheck.cpp — round-trip check and load benchmark for the settings in src/BoingSettings.h
+// Portable C++17, no Windows headers: runs LoadSettings/SaveSettings through the memory and file
+// backends the way the saver runs them through the registry. Build from the repository root, e.g.:
+//   g++ -std=c++17 -O2 -Isrc tools/BoingSettingsCheck.cpp -o BoingSettingsCheck
+//   ./BoingSettingsCheck [scratch file] [loads]     (exit 1 on any mismatch)
+// Checks: every value survives Save then Load on both backends; missing values load as defaults;
+// out-of-range values fall back to defaults, judged by the schema version that wrote them; the
+// file backend keeps values it does not own; the dialog's Restore keeps the registry-only values.
+// Then times loads from each backend.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "BoingSettings.h"
+
+static int g_failures = 0;
+
+static void Check(bool ok, const char* what, const char* backend) {
+    if (ok) return;
+    ++g_failures;
+    std::printf("  FAILED: %s (%s)\n", what, backend);
+}
+
+static bool SameSettings(const SaverSettings& a, const SaverSettings& b) {
+    return a.version == b.version && a.floorShadow == b.floorShadow && a.wallShadow == b.wallShadow &&
+        a.grid == b.grid && a.sound == b.sound && a.bgColor == b.bgColor && a.geometryMode == b.geometryMode &&
+        a.ballLighting == b.ballLighting && a.multiMonitorMode == b.multiMonitorMode && a.impostor == b.impostor &&
+        a.impactParticles == b.impactParticles && a.workerThreads == b.workerThreads &&
+        a.frameExport == b.frameExport && a.renderer == b.renderer && a.frameRateCap == b.frameRateCap &&
+        a.lowPower == b.lowPower;
+}
+
+// Every value away from its default, so a value that is not stored shows up
+static SaverSettings NonDefaultSettings() {
+    SaverSettings s;
+    s.floorShadow = false;
+    s.wallShadow = false;
+    s.grid = false;
+    s.sound = false;
+    s.bgColor = 0x00102030;
+    s.geometryMode = 0;
+    s.ballLighting = false;
+    s.multiMonitorMode = MONITOR_MODE_SPANNED;
+    s.impostor = true;
+    s.impactParticles = true;
+    s.workerThreads = 3;
+    s.frameExport = 4;
+    s.renderer = RENDERER_FIXED_FUNCTION;
+    s.frameRateCap = 48;
+    s.lowPower = LOW_POWER_NEVER;
+    return s;
+}
+
+// Write raw values the way an older build or a hand edit would leave them
+static void WriteRaw(SettingsBackend& backend, const wchar_t* name, uint32_t value) {
+    backend.OpenForWrite();
+    backend.WriteValue(name, value);
+    backend.Close();
+}
+
+static void CheckBackend(SettingsBackend& backend, const char* name, void (*reset)(SettingsBackend&)) {
+    // Nothing stored: defaults
+    reset(backend);
+    Check(SameSettings(LoadSettings(backend), DefaultSettings()), "empty store loads defaults", name);
+
+    // Round trip
+    const SaverSettings saved = NonDefaultSettings();
+    SaveSettings(backend, saved);
+    Check(SameSettings(LoadSettings(backend), saved), "save then load round-trips every value", name);
+    SaveSettings(backend, LoadSettings(backend));
+    Check(SameSettings(LoadSettings(backend), saved), "load, save, load is stable", name);
+
+    // Out-of-range values from this schema fall back, the rest are kept
+    WriteRaw(backend, L"MultiMonitorMode", 9);
+    WriteRaw(backend, L"Renderer", 7);
+    WriteRaw(backend, L"LowPower", 0xFFFFFFFFu);
+    SaverSettings loaded = LoadSettings(backend);
+    Check(loaded.multiMonitorMode == DefaultSettings().multiMonitorMode, "unknown monitor mode -> default", name);
+    Check(loaded.renderer == RENDERER_AUTO, "unknown renderer -> auto", name);
+    Check(loaded.lowPower == LOW_POWER_AUTO, "unknown low-power policy -> auto", name);
+    Check(loaded.frameRateCap == saved.frameRateCap && loaded.bgColor == saved.bgColor,
+        "in-range values survive a bad neighbour", name);
+
+    // The writer's schema decides: Spanned (4) only exists from schema 2 on
+    reset(backend);
+    WriteRaw(backend, L"MultiMonitorMode", (uint32_t)MONITOR_MODE_SPANNED);
+    Check(LoadSettings(backend).multiMonitorMode == DefaultSettings().multiMonitorMode,
+        "Spanned from an unversioned (schema 1) store -> default", name);
+    WriteRaw(backend, L"SettingsVersion", 1);
+    Check(LoadSettings(backend).multiMonitorMode == DefaultSettings().multiMonitorMode,
+        "Spanned from a schema 1 store -> default", name);
+    WriteRaw(backend, L"SettingsVersion", 2);
+    Check(LoadSettings(backend).multiMonitorMode == MONITOR_MODE_SPANNED, "Spanned from a schema 2 store is kept", name);
+    WriteRaw(backend, L"SettingsVersion", (uint32_t)SETTINGS_VERSION + 5);
+    loaded = LoadSettings(backend);
+    Check(loaded.multiMonitorMode == MONITOR_MODE_SPANNED && loaded.version == SETTINGS_VERSION,
+        "a newer schema loads with this schema's ranges", name);
+
+    // Saving marks the store with this schema
+    SaveSettings(backend, loaded);
+    uint32_t v = 0;
+    backend.OpenForRead();
+    Check(backend.ReadValue(L"SettingsVersion", v) && v == (uint32_t)SETTINGS_VERSION, "save writes SETTINGS_VERSION", name);
+    backend.Close();
+}
+
+static void ResetMemory(SettingsBackend& backend) {
+    ((MemorySettingsBackend&)backend).values.clear();
+}
+
+static std::string g_path;
+
+static void ResetFile(SettingsBackend&) {
+    std::remove(g_path.c_str());
+}
+
+static volatile uint32_t g_sink = 0;     // Keeps the timed loads from being optimized away
+
+// Mean microseconds per LoadSettings
+static double TimeLoads(SettingsBackend& backend, int loads) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) g_sink = g_sink + LoadSettings(backend).bgColor;
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    return us / loads;
+}
+
+int main(int argc, char** argv) {
+    g_path = argc > 1 ? argv[1] : "BoingSettingsCheck.ini";
+    const int loads = argc > 2 ? std::atoi(argv[2]) : 2000;
+    if (loads <= 0) {
+        std::fprintf(stderr, "usage: BoingSettingsCheck [scratch file] [loads]\n");
+        return 2;
+    }
+    std::printf("BoingSettingsCheck: schema %d, scratch file %s\n", SETTINGS_VERSION, g_path.c_str());
+
+    MemorySettingsBackend memory;
+    CheckBackend(memory, "memory", ResetMemory);
+
+    FileSettingsBackend file(g_path);
+    CheckBackend(file, "file", ResetFile);
+
+    // The file backend keeps lines it does not own across a save
+    ResetFile(file);
+    if (std::FILE* fp = std::fopen(g_path.c_str(), "w")) {
+        std::fprintf(fp, "SomeoneElses=42\nnot a value line\n");
+        std::fclose(fp);
+    }
+    SaveSettings(file, NonDefaultSettings());
+    uint32_t v = 0;
+    file.OpenForRead();
+    Check(file.ReadValue(L"SomeoneElses", v) && v == 42, "foreign value kept across a save", "file");
+    file.Close();
+    Check(SameSettings(LoadSettings(file), NonDefaultSettings()), "settings load next to a foreign value", "file");
+
+    // The dialog's Restore resets only what the dialog shows
+    const SaverSettings custom = NonDefaultSettings();
+    SaverSettings restored = DialogDefaults(custom);
+    Check(restored.workerThreads == custom.workerThreads && restored.frameExport == custom.frameExport &&
+        restored.renderer == custom.renderer && restored.frameRateCap == custom.frameRateCap &&
+        restored.lowPower == custom.lowPower, "Restore keeps the registry-only values", "dialog");
+    restored.workerThreads = DefaultSettings().workerThreads;
+    restored.frameExport = DefaultSettings().frameExport;
+    restored.renderer = DefaultSettings().renderer;
+    restored.frameRateCap = DefaultSettings().frameRateCap;
+    restored.lowPower = DefaultSettings().lowPower;
+    Check(SameSettings(restored, DefaultSettings()), "Restore resets every dialog value", "dialog");
+
+    // Load latency: one open and every value per load, as the saver does once per process
+    SaveSettings(memory, NonDefaultSettings());
+    const double memoryUs = TimeLoads(memory, loads);
+    const double fileUs = TimeLoads(file, loads);
+    std::printf("  load           %.2f us from memory, %.2f us from file (%d loads each)\n", memoryUs, fileUs, loads);
+
+    std::remove(g_path.c_str());
+    std::printf("  %s\n", g_failures ? "FAILED" : "all passed");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+// BoingStartupTimeline.cpp — headless startup timeline for the saver's startup path
+// Portable C++17, no Windows or GL headers: loads the settings, prepares the shared assets and
+// sets up N outputs the way the saver does, once serially and once on the job system in
+// src/BoingJobs.h, and prints the same phases as the saver's debugger line. Build from the
+// repository root, e.g. on Linux:
+//   g++ -std=c++17 -O2 -pthread -Isrc tools/BoingStartupTimeline.cpp -o BoingStartupTimeline
+//   ./BoingStartupTimeline [outputs] [driver ms] [threads] [sounds dir]     (threads 0 = one per core)
+// Without a GPU an output's setup is its upload copy of the texture and meshes plus its bounds;
+// "driver ms" adds a fixed wait per output for context creation (default 15, 0 = none). Exits 1
+// when the parallel run is more than 10% slower than the serial one.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BoingAssets.h"
+#include "BoingAudio.h"
+#include "BoingJobs.h"
+#include "BoingScene.h"
+#include "BoingSettings.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static JobSystem    g_jobs;
+static SharedAssets g_assets;
+static std::vector<unsigned char> g_soundFiles[SOUND_COUNT];   // The .ima.wav images the saver embeds
+static int          g_driverMs = 15;
+
+static double Ms(Clock::time_point t0, Clock::time_point t1) {
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static bool ReadFile(const std::string& path, std::vector<unsigned char>& out) {
+    std::FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    std::fseek(fp, 0, SEEK_END);
+    long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && std::fread(out.data(), 1, out.size(), fp) == out.size();
+    std::fclose(fp);
+    return ok;
+}
+
+static void DecodeSound(SharedAssets& assets, int s) {
+    const std::vector<unsigned char>& image = g_soundFiles[s];
+    if (image.empty() || !DecodeToPcmWave(image.data(), image.size(), assets.ownedSound[s])) return;
+    assets.sound[s].data = assets.ownedSound[s].data();
+    assets.sound[s].size = (uint32_t)assets.ownedSound[s].size();
+}
+
+// Stand-in for one output's context: what it uploads and the bounds it computes
+struct HeadlessOutput {
+    int    width = 0, height = 0;
+    std::vector<unsigned char> uploaded;
+    WorldBounds bounds;
+    double setupMs = 0.0;
+};
+
+static void SetupOutput(HeadlessOutput& out) {
+    const Clock::time_point t0 = Clock::now();
+    if (g_driverMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(g_driverMs));
+
+    const size_t checker = CheckerUploadBytes(g_assets);
+    out.uploaded.resize(checker + SphereUploadBytes(g_assets.sphere[0]) + SphereUploadBytes(g_assets.sphere[1]));
+    unsigned char* p = out.uploaded.data();
+    std::memcpy(p, g_assets.checkerTexels, checker);
+    p += checker;
+    for (const SphereMeshView& mesh : g_assets.sphere) {
+        const size_t v = (size_t)mesh.vertexCount;
+        std::memcpy(p, mesh.positions, v * 3 * sizeof(float)); p += v * 3 * sizeof(float);
+        std::memcpy(p, mesh.normals, v * 3 * sizeof(float));   p += v * 3 * sizeof(float);
+        std::memcpy(p, mesh.texcoords, v * 2 * sizeof(float)); p += v * 2 * sizeof(float);
+        std::memcpy(p, mesh.indices, (size_t)mesh.indexCount * sizeof(uint16_t));
+        p += (size_t)mesh.indexCount * sizeof(uint16_t);
+    }
+    out.bounds = SceneBoundsForSize(out.width, out.height);
+    out.setupMs = Ms(t0, Clock::now());
+}
+
+struct Timeline {
+    double settingsMs = 0.0, assetsWaitMs = 0.0, assetsJobsMs = 0.0, contextsMs = 0.0, totalMs = 0.0;
+};
+
+static void ResetAssets() {
+    g_assets = SharedAssets();
+}
+
+// Everything on the calling thread, one step after another (the saver before the job system)
+static Timeline RunSerial(MemorySettingsBackend& store, std::vector<HeadlessOutput>& outputs) {
+    Timeline t;
+    ResetAssets();
+    const Clock::time_point t0 = Clock::now();
+    const SaverSettings settings = LoadSettings(store);
+    const Clock::time_point t1 = Clock::now();
+    GenerateSharedAssets(g_assets);
+    if (settings.sound) for (int s = 0; s < SOUND_COUNT; ++s) DecodeSound(g_assets, s);
+    g_assets.ready = true;
+    const Clock::time_point t2 = Clock::now();
+    for (HeadlessOutput& out : outputs) SetupOutput(out);
+    const Clock::time_point t3 = Clock::now();
+
+    t.settingsMs = Ms(t0, t1);
+    t.assetsWaitMs = t.assetsJobsMs = Ms(t1, t2);
+    t.contextsMs = Ms(t2, t3);
+    t.totalMs = Ms(t0, t3);
+    return t;
+}
+
+// The saver's graph: one generator per asset and one decode per sound under a root job, then
+// every output set up at once
+static Clock::time_point g_assetsQueued, g_assetsFinished;
+
+static Timeline RunParallel(MemorySettingsBackend& store, std::vector<HeadlessOutput>& outputs) {
+    Timeline t;
+    ResetAssets();
+    const Clock::time_point t0 = Clock::now();
+    const SaverSettings settings = LoadSettings(store);
+    const Clock::time_point t1 = Clock::now();
+
+    g_assetsQueued = t1;
+    const bool sound = settings.sound;
+    Job* root = g_jobs.Create([sound](Job* self) {
+        g_jobs.Run(g_jobs.Create([](Job*) { GenerateCheckerAsset(g_assets); }, self));
+        for (int lod = 0; lod < 2; ++lod) {
+            g_jobs.Run(g_jobs.Create([lod](Job*) { GenerateSphereAsset(g_assets, lod); }, self));
+        }
+        if (sound) {
+            for (int s = 0; s < SOUND_COUNT; ++s) {
+                g_jobs.Run(g_jobs.Create([s](Job*) { DecodeSound(g_assets, s); }, self));
+            }
+        }
+    });
+    Job* done = g_jobs.Create([](Job*) {
+        g_assetsFinished = Clock::now();
+        g_assets.ready = true;
+    });
+    g_jobs.AddContinuation(root, done);
+    g_jobs.Run(root);
+    g_jobs.Wait(done);
+    const Clock::time_point t2 = Clock::now();
+
+    HeadlessOutput* first = outputs.data();
+    g_jobs.ParallelFor(outputs.size(), 1, [first](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) SetupOutput(first[i]);
+    });
+    const Clock::time_point t3 = Clock::now();
+
+    t.settingsMs = Ms(t0, t1);
+    t.assetsWaitMs = Ms(t1, t2);
+    t.assetsJobsMs = Ms(g_assetsQueued, g_assetsFinished);
+    t.contextsMs = Ms(t2, t3);
+    t.totalMs = Ms(t0, t3);
+    return t;
+}
+
+static void Report(const char* name, const Timeline& t, const std::vector<HeadlessOutput>& outputs) {
+    double slowest = 0.0;
+    for (const HeadlessOutput& out : outputs) slowest = out.setupMs > slowest ? out.setupMs : slowest;
+    std::printf("  %-8s settings %.2f ms, assets wait %.2f ms (jobs %.2f ms), contexts %.2f ms (%d outputs, slowest %.2f ms), total %.2f ms\n",
+        name, t.settingsMs, t.assetsWaitMs, t.assetsJobsMs, t.contextsMs, (int)outputs.size(), slowest, t.totalMs);
+}
+
+int main(int argc, char** argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 6;
+    g_driverMs = argc > 2 ? std::atoi(argv[2]) : 15;
+    const int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+    const std::string soundDir = argc > 4 ? argv[4] : "sounds";
+    if (count <= 0 || g_driverMs < 0 || threads < 0) {
+        std::fprintf(stderr, "usage: BoingStartupTimeline [outputs] [driver ms] [threads] [sounds dir]\n");
+        return 2;
+    }
+
+    const char* names[SOUND_COUNT] = { "/BoingBallF.ima.wav", "/BoingBallW.ima.wav" };
+    for (int s = 0; s < SOUND_COUNT; ++s) {
+        if (!ReadFile(soundDir + names[s], g_soundFiles[s]))
+            std::printf("  (no %s%s: sound decode not timed)\n", soundDir.c_str(), names[s]);
+    }
+
+    MemorySettingsBackend store;
+    SaveSettings(store, DefaultSettings());
+    if (threads) g_jobs.Start((unsigned)threads, (unsigned)threads);   // Oversubscribe if asked
+    else         g_jobs.Start(LoadSettings(store).workerThreads);
+    std::printf("BoingStartupTimeline: %d outputs, %d ms driver wait each, %u threads\n", count, g_driverMs, g_jobs.ThreadCount());
+
+    // A wall of 1920x1080 panels with one odd size, as multi-monitor setups tend to be
+    std::vector<HeadlessOutput> outputs((size_t)count);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        outputs[i].width = i + 1 == outputs.size() && i > 0 ? 2560 : 1920;
+        outputs[i].height = i + 1 == outputs.size() && i > 0 ? 1440 : 1080;
+    }
+
+    RunParallel(store, outputs);   // Warm up: page in the allocator and the workers
+    const Timeline serial = RunSerial(store, outputs);
+    Report("serial", serial, outputs);
+    const Timeline parallel = RunParallel(store, outputs);
+    Report("parallel", parallel, outputs);
+
+    bool ok = true;
+    for (const HeadlessOutput& out : outputs) ok = ok && out.uploaded.size() > 0 && out.bounds.wallX > 0.0f;
+    if (!ok) std::printf("  FAILED: an output was not set up\n");
+    if (g_jobs.ThreadCount() > 1 && parallel.totalMs > serial.totalMs * 1.1) {
+        std::printf("  FAILED: parallel startup slower than serial\n");
+        ok = false;
+    } else {
+        std::printf("  speedup %.2fx\n", serial.totalMs / (parallel.totalMs > 0.0 ? parallel.totalMs : 1e-9));
+    }
+    g_jobs.Stop();
+    return ok ? 0 : 1;
+}